@@ -0,0 +1,291 @@
+#include "ai.h"
+#include "utils.h"
+#include "tuning.h"
+#include "raymath.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define AI_THREAT_RADIUS 320.0f
+#define AI_THREAT_HORIZON 1.5f
+#define AI_THREAT_MARGIN 12.0f
+#define AI_HYPERSPACE_TIME 0.12f
+#define AI_EVADE_TIME 0.8f
+#define AI_FIRE_TOLERANCE 4.0f
+#define AI_TURN_DEADZONE 2.0f
+// Threats scored per tick, the nearest ones first
+#define AI_MAX_THREATS 64
+// How many targets are scored between deadline checks
+#define AI_DEADLINE_STRIDE 8
+
+typedef struct {
+    Vector2 offset;
+    Vector2 velocity;
+    float radius;
+    bool hostile;
+} AITrack;
+
+struct AIScratch {
+    Broadphase broadphase;
+    BroadphaseEntry candidates[BROADPHASE_MAX_ENTRIES];
+};
+
+static float AngleDifference(float from, float to) {
+    return fmodf(to - from + 540.0f, 360.0f) - 180.0f;
+}
+
+static unsigned int TurnTowards(float rotation, float angle) {
+    float diff = AngleDifference(rotation, angle);
+    if (diff > AI_TURN_DEADZONE) return ACTION_ROTATE_RIGHT;
+    if (diff < -AI_TURN_DEADZONE) return ACTION_ROTATE_LEFT;
+    return 0;
+}
+
+// Solves |d + v t| = s t for the earliest t > 0. The angle uses the ship/bullet
+// convention where 0 degrees points up the screen.
+bool ComputeLeadAngle(Vector2 shooter, Vector2 target, Vector2 targetVelocity, float projectileSpeed, float* angle) {
+    Vector2 d = Vector2Subtract(target, shooter);
+    float a = Vector2DotProduct(targetVelocity, targetVelocity) - projectileSpeed * projectileSpeed;
+    float b = 2.0f * Vector2DotProduct(d, targetVelocity);
+    float c = Vector2DotProduct(d, d);
+    float t;
+    
+    if (fabsf(a) < 1e-6f) {
+        if (fabsf(b) < 1e-6f) return false;
+        t = -c / b;
+    } else {
+        float discriminant = b * b - 4 * a * c;
+        if (discriminant < 0) return false;
+        float root = sqrtf(discriminant);
+        float t1 = (-b - root) / (2 * a);
+        float t2 = (-b + root) / (2 * a);
+        t = (t1 > 0 && (t1 < t2 || t2 <= 0)) ? t1 : t2;
+    }
+    if (t <= 0) return false;
+    
+    Vector2 aim = Vector2Add(d, Vector2Scale(targetVelocity, t));
+    *angle = GetHeadingDegrees(aim) + 90;
+    return true;
+}
+
+static bool ResolveTrack(const GameState* state, BroadphaseEntry entry, AITrack* track) {
+    const Spaceship* ship = &state->ship;
+    Vector2 position;
+    
+    switch (entry.kind) {
+        case ENTITY_KIND_ASTEROID:
+            position = state->asteroids[entry.index].position;
+            track->velocity = state->asteroids[entry.index].velocity;
+            track->radius = state->asteroids[entry.index].radius;
+            track->hostile = true;
+            break;
+        case ENTITY_KIND_BULLET:
+            position = state->bullets[entry.index].position;
+            track->velocity = state->bullets[entry.index].velocity;
+            track->radius = BULLET_RADIUS;
+            track->hostile = !state->bullets[entry.index].fromPlayer;
+            break;
+        case ENTITY_KIND_UFO:
+            position = state->ufos[entry.index].position;
+            track->velocity = state->ufos[entry.index].velocity;
+            track->radius = UFO_SIZE;
+            track->hostile = true;
+            break;
+        default:
+            return false;
+    }
+    
+    track->offset = GetWrappedOffset(ship->position, position, state->worldWidth, state->worldHeight);
+    return track->hostile;
+}
+
+// Time until the closest approach that would hit the ship, or FLT_MAX if none does within the horizon
+static float TimeToImpact(const Spaceship* ship, const AITrack* track) {
+    Vector2 v = Vector2Subtract(track->velocity, ship->velocity);
+    float speedSq = Vector2DotProduct(v, v);
+    float t = (speedSq > 1e-6f) ? -Vector2DotProduct(track->offset, v) / speedSq : 0;
+    if (t < 0) t = 0;
+    if (t > AI_THREAT_HORIZON) return FLT_MAX;
+    
+    Vector2 closest = Vector2Add(track->offset, Vector2Scale(v, t));
+    float reach = track->radius + SPACESHIP_SIZE + AI_THREAT_MARGIN;
+    return (Vector2LengthSqr(closest) < reach * reach) ? t : FLT_MAX;
+}
+
+// Keeps the closest hostile tracks, nearest first, so a crowded swarm cell
+// visited early can never push a nearer threat out of the list
+static int SelectNearestThreats(const GameState* state, const BroadphaseEntry* candidates, int candidateCount,
+                                AITrack threats[AI_MAX_THREATS]) {
+    float gaps[AI_MAX_THREATS];
+    int count = 0;
+    
+    for (int i = 0; i < candidateCount; i++) {
+        AITrack track;
+        if (!ResolveTrack(state, candidates[i], &track)) continue;
+        float gap = Vector2Length(track.offset) - track.radius;
+        if (count == AI_MAX_THREATS && gap >= gaps[count - 1]) continue;
+        
+        int slot = count < AI_MAX_THREATS ? count++ : count - 1;
+        while (slot > 0 && gaps[slot - 1] > gap) {
+            gaps[slot] = gaps[slot - 1];
+            threats[slot] = threats[slot - 1];
+            slot--;
+        }
+        gaps[slot] = gap;
+        threats[slot] = track;
+    }
+    return count;
+}
+
+static unsigned int PlanAttractPilot(AIPilot* pilot, const GameState* state, double deadline) {
+    const Spaceship* ship = &state->ship;
+    if (!ship->isAlive) return 0;
+    
+    // The grid build is not interruptible, so the deadline is checked on either side of
+    // it; when it runs out the budget the previous turn and thrust are held for this tick
+    unsigned int heldActions = pilot->lastActions & ~(ACTION_FIRE | ACTION_HYPERSPACE);
+    if (GetMonotonicTime() > deadline) return heldActions;
+    
+    AIScratch* scratch = pilot->scratch;
+    BuildBroadphase(&scratch->broadphase, state);
+    if (GetMonotonicTime() > deadline) return heldActions;
+    
+    float soonest = FLT_MAX;
+    Vector2 threatOffset = {0};
+    
+    if (!IsSpaceshipInvulnerable(ship)) {
+        // Threat evaluation only looks at broadphase neighbours of the ship
+        int candidateCount = QueryBroadphase(&scratch->broadphase, ship->position, AI_THREAT_RADIUS,
+                                             scratch->candidates, BROADPHASE_MAX_ENTRIES);
+        AITrack threats[AI_MAX_THREATS];
+        int threatCount = SelectNearestThreats(state, scratch->candidates, candidateCount, threats);
+        
+        for (int i = 0; i < threatCount; i++) {
+            if (i > 0 && i % AI_DEADLINE_STRIDE == 0 && GetMonotonicTime() > deadline) break;
+            
+            float t = TimeToImpact(ship, &threats[i]);
+            if (t < soonest) {
+                soonest = t;
+                threatOffset = threats[i].offset;
+            }
+        }
+    }
+    
+    if (soonest < AI_HYPERSPACE_TIME) {
+        return ACTION_HYPERSPACE;
+    }
+    if (soonest < AI_EVADE_TIME) {
+        // Turn away from the threat and burn
+        float away = GetHeadingDegrees((Vector2){-threatOffset.x, -threatOffset.y}) + 90;
+        return TurnTowards(ship->rotation, away) | ACTION_THRUST;
+    }
+    
+    // Target selection: cheapest turn to a lead solution, refined until the deadline
+    float bestCost = FLT_MAX;
+    float bestAngle = ship->rotation;
+    int scored = 0;
+    
+    for (int i = 0; i < state->maxAsteroids + MAX_UFOS; i++) {
+        bool isUFO = i >= state->maxAsteroids;
+        const Asteroid* asteroid = isUFO ? nullptr : &state->asteroids[i];
+        const UFO* ufo = isUFO ? &state->ufos[i - state->maxAsteroids] : nullptr;
+        if (isUFO ? !ufo->isActive : !asteroid->isActive) continue;
+        
+        if (++scored % AI_DEADLINE_STRIDE == 0 && GetMonotonicTime() > deadline) break;
+        
+        Vector2 position = isUFO ? ufo->position : asteroid->position;
+        Vector2 velocity = isUFO ? ufo->velocity : asteroid->velocity;
+        Vector2 offset = GetWrappedOffset(ship->position, position, state->worldWidth, state->worldHeight);
+        
+        float angle;
+        if (!ComputeLeadAngle((Vector2){0, 0}, offset, velocity, tuning->bulletSpeed, &angle)) continue;
+        
+        float distance = Vector2Length(offset);
+        if (distance > tuning->bulletSpeed * tuning->bulletLifetime) continue;
+        
+        float cost = fabsf(AngleDifference(ship->rotation, angle)) + distance * 0.05f + (isUFO ? -30.0f : 0.0f);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestAngle = angle;
+        }
+    }
+    
+    if (bestCost == FLT_MAX) {
+        return TurnTowards(ship->rotation, ship->rotation + 90);
+    }
+    
+    unsigned int actions = TurnTowards(ship->rotation, bestAngle);
+    bool aligned = fabsf(AngleDifference(ship->rotation, bestAngle)) < AI_FIRE_TOLERANCE;
+    if (aligned && CanFireBullet(state) && !(pilot->lastActions & ACTION_FIRE)) {
+        actions |= ACTION_FIRE;
+    }
+    return actions;
+}
+
+static bool HasFreeBullet(const GameState* state) {
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!state->bullets[i].isActive) return true;
+    }
+    return false;
+}
+
+// Small UFOs lead the ship, falling back to aiming straight at it when no
+// intercept exists; large UFOs fire at random. Holds fire while the bullet
+// pool is full so the random stream only advances for shots taken.
+static unsigned int PlanUFOGunner(AIPilot* pilot, const GameState* state, double deadline) {
+    (void)deadline;
+    const UFO* ufo = &state->ufos[pilot->ufo];
+    const Spaceship* target = &state->ship;
+    if (!ufo->isActive || !HasFreeBullet(state)) return 0;
+    
+    if (ufo->type == UFO_SMALL && target->isAlive) {
+        if (!ComputeLeadAngle(ufo->position, target->position, target->velocity, tuning->bulletSpeed, &pilot->aim)) {
+            pilot->aim = GetHeadingDegrees(Vector2Subtract(target->position, ufo->position)) + 90;
+        }
+    } else {
+        pilot->aim = RandomFloat(0, 360);
+    }
+    return ACTION_FIRE;
+}
+
+const AIBehaviour AI_BEHAVIOUR_ATTRACT = {
+    .name = "attract",
+    .plan = PlanAttractPilot,
+    .needsScratch = true
+};
+
+const AIBehaviour AI_BEHAVIOUR_UFO_GUNNER = {
+    .name = "ufo-gunner",
+    .plan = PlanUFOGunner
+};
+
+bool InitAIPilot(AIPilot* pilot, const AIBehaviour* behaviour, int budgetMicroseconds) {
+    *pilot = (AIPilot){0};
+    pilot->behaviour = behaviour;
+    pilot->budget = budgetMicroseconds * 1e-6;
+    
+    // Swarm levels make the grid and query results too large for the stack
+    if (behaviour->needsScratch) {
+        pilot->scratch = malloc(sizeof(AIScratch));
+        if (!pilot->scratch) return false;
+    }
+    return true;
+}
+
+void CloseAIPilot(AIPilot* pilot) {
+    free(pilot->scratch);
+    pilot->scratch = nullptr;
+}
+
+unsigned int UpdateAIPilot(AIPilot* pilot, const GameState* state) {
+    double start = GetMonotonicTime();
+    unsigned int actions = pilot->behaviour->plan(pilot, state, start + pilot->budget);
+    double elapsed = GetMonotonicTime() - start;
+    
+    pilot->ticks++;
+    if (elapsed > pilot->budget) pilot->overBudgetTicks++;
+    if (elapsed > pilot->worstPlanTime) pilot->worstPlanTime = elapsed;
+    
+    pilot->lastActions = actions;
+    return actions;
+}
\ No newline at end of file
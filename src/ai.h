@@ -0,0 +1,46 @@
+#ifndef AI_H
+#define AI_H
+
+#include "game.h"
+#include "broadphase.h"
+
+#define AI_DEFAULT_BUDGET_US 500
+#define AI_UFO_BUDGET_US 50
+
+typedef struct AIPilot AIPilot;
+typedef struct AIScratch AIScratch;
+
+// Planners must return the best actions found so far once the deadline passes.
+// A gunner's plan feeds the simulation, so it does a fixed amount of work and
+// leaves the deadline to the accounting: replays must not depend on wall time.
+typedef unsigned int (*AIPlanFunction)(AIPilot* pilot, const GameState* state, double deadline);
+
+typedef struct {
+    const char* name;
+    AIPlanFunction plan;
+    bool needsScratch;
+} AIBehaviour;
+
+struct AIPilot {
+    const AIBehaviour* behaviour;
+    double budget;
+    AIScratch* scratch;
+    // Gunners fly a UFO slot and return ACTION_FIRE with the heading in aim
+    int ufo;
+    float aim;
+    unsigned int lastActions;
+    long ticks;
+    long overBudgetTicks;
+    double worstPlanTime;
+};
+
+extern const AIBehaviour AI_BEHAVIOUR_ATTRACT;
+extern const AIBehaviour AI_BEHAVIOUR_UFO_GUNNER;
+
+bool InitAIPilot(AIPilot* pilot, const AIBehaviour* behaviour, int budgetMicroseconds);
+void CloseAIPilot(AIPilot* pilot);
+unsigned int UpdateAIPilot(AIPilot* pilot, const GameState* state);
+
+bool ComputeLeadAngle(Vector2 shooter, Vector2 target, Vector2 targetVelocity, float projectileSpeed, float* angle);
+
+#endif
\ No newline at end of file
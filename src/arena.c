@@ -0,0 +1,70 @@
+#include "arena.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+struct Arena {
+    size_t capacity;
+    size_t used;
+    size_t tagged[MEMORY_TAG_COUNT];
+    unsigned char data[];
+};
+
+Arena* CreateArena(size_t capacity) {
+    // calloc hands back zeroed pages, so allocations need no clearing of their own
+    Arena* arena = calloc(1, sizeof(Arena) + capacity);
+    if (!arena) return nullptr;
+    arena->capacity = capacity;
+    return arena;
+}
+
+void DestroyArena(Arena* arena) {
+    free(arena);
+}
+
+size_t GetArenaAllocSize(size_t size, size_t alignment) {
+    return size + (alignment > 1 ? alignment - 1 : 0);
+}
+
+void* ArenaAlloc(Arena* arena, size_t size, size_t alignment, MemoryTag tag) {
+    if (alignment == 0) alignment = ARENA_DEFAULT_ALIGNMENT;
+    
+    uintptr_t base = (uintptr_t)arena->data;
+    uintptr_t start = (base + arena->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t end = (size_t)(start - base) + size;
+    if (end > arena->capacity) return nullptr;
+    
+    arena->used = end;
+    arena->tagged[tag] += size;
+    return (void*)start;
+}
+
+size_t GetArenaCapacity(const Arena* arena) {
+    return arena->capacity;
+}
+
+size_t GetArenaUsed(const Arena* arena) {
+    return arena->used;
+}
+
+size_t GetArenaTagged(const Arena* arena, MemoryTag tag) {
+    return arena->tagged[tag];
+}
+
+const char* GetMemoryTagName(MemoryTag tag) {
+    static const char* names[MEMORY_TAG_COUNT] = {
+        [MEMORY_TAG_STATE] = "state",
+        [MEMORY_TAG_ASTEROIDS] = "asteroids",
+        [MEMORY_TAG_WORLD] = "world chunks",
+        [MEMORY_TAG_ENV] = "environment",
+        [MEMORY_TAG_FRAMEBUFFER] = "framebuffer"
+    };
+    return (tag >= 0 && tag < MEMORY_TAG_COUNT) ? names[tag] : "unknown";
+}
+
+void WriteArenaReport(const Arena* arena, const char* name, FILE* out) {
+    fprintf(out, "%s: %zu of %zu bytes used (%zu header)\n", name, arena->used, arena->capacity, sizeof(Arena));
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; tag++) {
+        if (arena->tagged[tag] == 0) continue;
+        fprintf(out, "  %-14s %10zu\n", GetMemoryTagName(tag), arena->tagged[tag]);
+    }
+}
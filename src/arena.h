@@ -0,0 +1,41 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Bump allocator over one block. Allocations are never freed one by one:
+// the whole arena goes in a single free, so a session's memory is released
+// in O(1) however much it holds. Every allocation is tagged so a report can
+// say where the bytes went.
+
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+typedef enum {
+    MEMORY_TAG_STATE,
+    MEMORY_TAG_ASTEROIDS,
+    MEMORY_TAG_WORLD,
+    MEMORY_TAG_ENV,
+    MEMORY_TAG_FRAMEBUFFER,
+    MEMORY_TAG_COUNT
+} MemoryTag;
+
+typedef struct Arena Arena;
+
+// Capacity is fixed at creation; the arena's own header is outside it
+Arena* CreateArena(size_t capacity);
+void DestroyArena(Arena* arena);
+
+// Zeroed memory, or nullptr once the arena is full
+void* ArenaAlloc(Arena* arena, size_t size, size_t alignment, MemoryTag tag);
+
+// Worst-case bytes ArenaAlloc uses for an allocation, for sizing an arena up front
+size_t GetArenaAllocSize(size_t size, size_t alignment);
+
+size_t GetArenaCapacity(const Arena* arena);
+size_t GetArenaUsed(const Arena* arena);
+size_t GetArenaTagged(const Arena* arena, MemoryTag tag);
+const char* GetMemoryTagName(MemoryTag tag);
+void WriteArenaReport(const Arena* arena, const char* name, FILE* out);
+
+#endif
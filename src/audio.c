@@ -1,8 +1,17 @@
 #include "audio.h"
+#include "utils.h"
 #include "raylib.h"
 #include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
 
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+#endif
+
+#define SOUND_SAMPLE_RATE 44100
+
 typedef struct {
     Sound shoot;
     Sound explosion;
@@ -11,11 +20,36 @@ typedef struct {
     Sound ufo;
     bool thrustPlaying;
     bool ufoPlaying;
+    bool ready;
 } GameSounds;
 
 static GameSounds sounds = {0};
 
-static Sound CreateSyntheticSound(float frequency, float duration, int sampleRate) {
+typedef struct {
+    Wave shoot;
+    Wave explosion;
+    Wave thrust;
+    Wave hyperspace;
+    Wave ufo;
+} GameWaves;
+
+// Opening the device and synthesizing the sounds happen off the frame
+// thread; the frame thread turns the waves into sounds once both are done
+typedef struct {
+    bool started;
+    bool joined;
+    atomic_bool finished;
+    double readyTime;
+    GameWaves waves;
+#if !defined(PLATFORM_WEB)
+    pthread_t thread;
+    bool threaded;
+#endif
+} AudioStartup;
+
+static AudioStartup startup = {0};
+
+static Wave SynthesizeTone(float frequency, float duration, int sampleRate) {
     int sampleCount = (int)(duration * sampleRate);
     float* data = calloc(sampleCount, sizeof(float));
     
@@ -37,20 +71,20 @@ static Sound CreateSyntheticSound(float frequency, float duration, int sampleRat
         .data = data
     };
     
-    Sound sound = LoadSoundFromWave(wave);
-    UnloadWave(wave);
-    
-    return sound;
+    return wave;
 }
 
-static Sound CreateNoiseSound(float duration, int sampleRate) {
+static Wave SynthesizeNoise(float duration, int sampleRate) {
     int sampleCount = (int)(duration * sampleRate);
     float* data = calloc(sampleCount, sizeof(float));
     
+    // A private LCG: this runs beside window creation, which reseeds raylib's generator
+    uint32_t noise = 0x5EEDu;
     for (int i = 0; i < sampleCount; i++) {
         float t = (float)i / sampleRate;
         float envelope = 1.0f - (t / duration);
-        data[i] = ((float)GetRandomValue(-100, 100) / 100.0f) * envelope * 0.3f;
+        noise = noise * 1664525u + 1013904223u;
+        data[i] = ((float)((int)(noise >> 16) % 201 - 100) / 100.0f) * envelope * 0.3f;
     }
     
     Wave wave = {
@@ -61,43 +95,137 @@ static Sound CreateNoiseSound(float duration, int sampleRate) {
         .data = data
     };
     
-    Sound sound = LoadSoundFromWave(wave);
-    UnloadWave(wave);
+    return wave;
+}
+
+static void PrepareGameAudio(void) {
+    double start = GetMonotonicTime();
+    InitAudioDevice();
+    
+    startup.waves.shoot = SynthesizeTone(500.0f, 0.1f, SOUND_SAMPLE_RATE);
+    startup.waves.explosion = SynthesizeNoise(0.3f, SOUND_SAMPLE_RATE);
+    startup.waves.thrust = SynthesizeTone(100.0f, 0.5f, SOUND_SAMPLE_RATE);
+    startup.waves.hyperspace = SynthesizeTone(800.0f, 0.2f, SOUND_SAMPLE_RATE);
+    startup.waves.ufo = SynthesizeTone(150.0f, 2.0f, SOUND_SAMPLE_RATE);
+    
+    startup.readyTime = GetMonotonicTime() - start;
+    atomic_store_explicit(&startup.finished, true, memory_order_release);
+}
+
+#if !defined(PLATFORM_WEB)
+static void* AudioStartupThread(void* arg) {
+    (void)arg;
+    PrepareGameAudio();
+    return nullptr;
+}
+#endif
+
+static void UnloadGameWaves(void) {
+    UnloadWave(startup.waves.shoot);
+    UnloadWave(startup.waves.explosion);
+    UnloadWave(startup.waves.thrust);
+    UnloadWave(startup.waves.hyperspace);
+    UnloadWave(startup.waves.ufo);
+    startup.waves = (GameWaves){0};
+}
+
+// Waits for the startup work, or in the browser does it
+static void JoinAudioStartup(void) {
+    if (!startup.started || startup.joined) return;
+#if defined(PLATFORM_WEB)
+    if (!atomic_load_explicit(&startup.finished, memory_order_acquire)) PrepareGameAudio();
+#else
+    if (startup.threaded) pthread_join(startup.thread, nullptr);
+#endif
+    startup.joined = true;
+}
+
+// Sounds are silent until the device is open; the first frame never waits on it
+void StartGameAudio(void) {
+    if (startup.started) return;
+    startup.started = true;
     
-    return sound;
+#if !defined(PLATFORM_WEB)
+    startup.threaded = pthread_create(&startup.thread, nullptr, AudioStartupThread, nullptr) == 0;
+    if (!startup.threaded) {
+        PrepareGameAudio();
+    }
+#endif
 }
 
-void InitGameAudio(void) {
-    sounds.shoot = CreateSyntheticSound(500.0f, 0.1f, 44100);
-    sounds.explosion = CreateNoiseSound(0.3f, 44100);
-    sounds.thrust = CreateSyntheticSound(100.0f, 0.5f, 44100);
-    sounds.hyperspace = CreateSyntheticSound(800.0f, 0.2f, 44100);
-    sounds.ufo = CreateSyntheticSound(150.0f, 2.0f, 44100);
+// In the browser there are no threads, so the work runs here on the first
+// call, which comes after the first frame is on screen. Returns true on the
+// frame the sounds become ready.
+bool UpdateGameAudio(void) {
+    if (!startup.started || startup.joined) return false;
+#if !defined(PLATFORM_WEB)
+    if (!atomic_load_explicit(&startup.finished, memory_order_acquire)) return false;
+#endif
+    JoinAudioStartup();
+    
+    if (!IsAudioDeviceReady()) {
+        TraceLog(LOG_WARNING, "ASTEROIDS: No audio device; playing without sound");
+        UnloadGameWaves();
+        return false;
+    }
+    
+    sounds.shoot = LoadSoundFromWave(startup.waves.shoot);
+    sounds.explosion = LoadSoundFromWave(startup.waves.explosion);
+    sounds.thrust = LoadSoundFromWave(startup.waves.thrust);
+    sounds.hyperspace = LoadSoundFromWave(startup.waves.hyperspace);
+    sounds.ufo = LoadSoundFromWave(startup.waves.ufo);
+    UnloadGameWaves();
     
     SetSoundVolume(sounds.shoot, 0.5f);
     SetSoundVolume(sounds.explosion, 0.6f);
     SetSoundVolume(sounds.thrust, 0.3f);
     SetSoundVolume(sounds.hyperspace, 0.4f);
     SetSoundVolume(sounds.ufo, 0.3f);
+    
+    sounds.ready = true;
+    return true;
+}
+
+bool IsGameAudioReady(void) {
+    return sounds.ready;
+}
+
+// How long opening the device and synthesis took, wherever they ran
+double GetGameAudioStartupTime(void) {
+    return startup.readyTime;
 }
 
+// Closes the device too, since StartGameAudio opened it
 void CloseGameAudio(void) {
-    UnloadSound(sounds.shoot);
-    UnloadSound(sounds.explosion);
-    UnloadSound(sounds.thrust);
-    UnloadSound(sounds.hyperspace);
-    UnloadSound(sounds.ufo);
+    if (!startup.started) return;
+    JoinAudioStartup();
+    
+    if (sounds.ready) {
+        UnloadSound(sounds.shoot);
+        UnloadSound(sounds.explosion);
+        UnloadSound(sounds.thrust);
+        UnloadSound(sounds.hyperspace);
+        UnloadSound(sounds.ufo);
+    }
+    UnloadGameWaves();
+    if (IsAudioDeviceReady()) CloseAudioDevice();
+    
+    sounds = (GameSounds){0};
+    startup = (AudioStartup){0};
 }
 
 void PlayShootSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     PlaySound(sounds.shoot);
 }
 
 void PlayExplosionSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     PlaySound(sounds.explosion);
 }
 
 void PlayThrustSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     if (!sounds.thrustPlaying) {
         PlaySound(sounds.thrust);
         sounds.thrustPlaying = true;
@@ -105,6 +233,7 @@ void PlayThrustSound(void) {
 }
 
 void StopThrustSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     if (sounds.thrustPlaying) {
         StopSound(sounds.thrust);
         sounds.thrustPlaying = false;
@@ -112,10 +241,12 @@ void StopThrustSound(void) {
 }
 
 void PlayHyperspaceSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     PlaySound(sounds.hyperspace);
 }
 
 void PlayUFOSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     if (!sounds.ufoPlaying) {
         PlaySound(sounds.ufo);
         sounds.ufoPlaying = true;
@@ -123,6 +254,7 @@ void PlayUFOSound(void) {
 }
 
 void StopUFOSound(void) {
+    if (!sounds.ready || !AreEffectsEnabled()) return;
     if (sounds.ufoPlaying) {
         StopSound(sounds.ufo);
         sounds.ufoPlaying = false;
@@ -1,7 +1,15 @@
 #ifndef AUDIO_H
 #define AUDIO_H
 
-void InitGameAudio(void);
+#include <stdbool.h>
+
+// The audio device is opened and the sounds synthesized in the background,
+// so the first frame does not wait on slow audio backends. Until
+// UpdateGameAudio() reports them ready, the Play/Stop calls do nothing.
+void StartGameAudio(void);
+bool UpdateGameAudio(void);
+bool IsGameAudioReady(void);
+double GetGameAudioStartupTime(void);
 void CloseGameAudio(void);
 
 void PlayShootSound(void);
@@ -0,0 +1,106 @@
+#include "broadphase.h"
+#include <math.h>
+#include <string.h>
+
+// Largest entity radius; queries grow by this so centre-binned entities are never missed
+#define BROADPHASE_MAX_ENTITY_RADIUS (ASTEROID_LARGE_RADIUS * ASTEROID_SHAPE_MAX_SCALE)
+
+static int CellIndex(const Broadphase* broadphase, int column, int row) {
+    column %= broadphase->columns;
+    row %= broadphase->rows;
+    if (column < 0) column += broadphase->columns;
+    if (row < 0) row += broadphase->rows;
+    return row * broadphase->columns + column;
+}
+
+static int CellOf(const Broadphase* broadphase, Vector2 position) {
+    return CellIndex(broadphase,
+                     (int)floorf(position.x / broadphase->cellWidth),
+                     (int)floorf(position.y / broadphase->cellHeight));
+}
+
+static int GatherEntities(const GameState* state, BroadphaseEntry* entries, Vector2* positions) {
+    int count = 0;
+    
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        if (!state->asteroids[i].isActive) continue;
+        entries[count] = (BroadphaseEntry){ENTITY_KIND_ASTEROID, i};
+        positions[count++] = state->asteroids[i].position;
+    }
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!state->bullets[i].isActive) continue;
+        entries[count] = (BroadphaseEntry){ENTITY_KIND_BULLET, i};
+        positions[count++] = state->bullets[i].position;
+    }
+    for (int i = 0; i < MAX_UFOS; i++) {
+        if (!state->ufos[i].isActive) continue;
+        entries[count] = (BroadphaseEntry){ENTITY_KIND_UFO, i};
+        positions[count++] = state->ufos[i].position;
+    }
+    
+    return count;
+}
+
+// Counting sort of live entities into cells, so each cell is one contiguous run
+void BuildBroadphase(Broadphase* broadphase, const GameState* state) {
+    int columns = (int)ceilf(state->worldWidth / BROADPHASE_CELL_SIZE);
+    int rows = (int)ceilf(state->worldHeight / BROADPHASE_CELL_SIZE);
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+    if (columns > BROADPHASE_MAX_COLUMNS) columns = BROADPHASE_MAX_COLUMNS;
+    if (rows > BROADPHASE_MAX_ROWS) rows = BROADPHASE_MAX_ROWS;
+    
+    broadphase->columns = columns;
+    broadphase->rows = rows;
+    broadphase->cellWidth = state->worldWidth / columns;
+    broadphase->cellHeight = state->worldHeight / rows;
+    
+    BroadphaseEntry* gathered = broadphase->gathered;
+    Vector2* positions = broadphase->positions;
+    int* cells = broadphase->cells;
+    int count = GatherEntities(state, gathered, positions);
+    int cellCount = columns * rows;
+    
+    memset(broadphase->cellStart, 0, (cellCount + 1) * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        cells[i] = CellOf(broadphase, positions[i]);
+        broadphase->cellStart[cells[i] + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) {
+        broadphase->cellStart[c + 1] += broadphase->cellStart[c];
+    }
+    
+    int cursor[BROADPHASE_MAX_COLUMNS * BROADPHASE_MAX_ROWS];
+    memcpy(cursor, broadphase->cellStart, cellCount * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        broadphase->entries[cursor[cells[i]]++] = gathered[i];
+    }
+    broadphase->entryCount = count;
+}
+
+// Returns candidates whose cell overlaps the query circle, wrapping at playfield edges
+int QueryBroadphase(const Broadphase* broadphase, Vector2 center, float radius,
+                    BroadphaseEntry* results, int maxResults) {
+    float reach = radius + BROADPHASE_MAX_ENTITY_RADIUS;
+    int c0 = (int)floorf((center.x - reach) / broadphase->cellWidth);
+    int c1 = (int)floorf((center.x + reach) / broadphase->cellWidth);
+    int r0 = (int)floorf((center.y - reach) / broadphase->cellHeight);
+    int r1 = (int)floorf((center.y + reach) / broadphase->cellHeight);
+    
+    // Never visit a wrapped cell twice when the query covers the whole playfield
+    if (c1 - c0 >= broadphase->columns) c1 = c0 + broadphase->columns - 1;
+    if (r1 - r0 >= broadphase->rows) r1 = r0 + broadphase->rows - 1;
+    
+    int found = 0;
+    for (int row = r0; row <= r1; row++) {
+        for (int column = c0; column <= c1; column++) {
+            int cell = CellIndex(broadphase, column, row);
+            for (int e = broadphase->cellStart[cell]; e < broadphase->cellStart[cell + 1]; e++) {
+                if (found == maxResults) return found;
+                results[found++] = broadphase->entries[e];
+            }
+        }
+    }
+    
+    return found;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "game.h"
+
+// Uniform grid over the wrapping playfield, rebuilt from a GameState each tick
+
+#define BROADPHASE_CELL_SIZE 128.0f
+#define BROADPHASE_MAX_COLUMNS 32
+#define BROADPHASE_MAX_ROWS 32
+#define BROADPHASE_MAX_ENTRIES (MAX_SWARM_ASTEROIDS + MAX_BULLETS + MAX_UFOS)
+
+typedef enum {
+    ENTITY_KIND_ASTEROID,
+    ENTITY_KIND_BULLET,
+    ENTITY_KIND_UFO
+} EntityKind;
+
+typedef struct {
+    EntityKind kind;
+    int index;
+} BroadphaseEntry;
+
+typedef struct {
+    int columns;
+    int rows;
+    float cellWidth;
+    float cellHeight;
+    int cellStart[BROADPHASE_MAX_COLUMNS * BROADPHASE_MAX_ROWS + 1];
+    BroadphaseEntry entries[BROADPHASE_MAX_ENTRIES];
+    int entryCount;
+    
+    // Build scratch, kept here because swarm levels make it too large for the stack
+    BroadphaseEntry gathered[BROADPHASE_MAX_ENTRIES];
+    Vector2 positions[BROADPHASE_MAX_ENTRIES];
+    int cells[BROADPHASE_MAX_ENTRIES];
+} Broadphase;
+
+void BuildBroadphase(Broadphase* broadphase, const GameState* state);
+int QueryBroadphase(const Broadphase* broadphase, Vector2 center, float radius,
+                    BroadphaseEntry* results, int maxResults);
+
+#endif
\ No newline at end of file
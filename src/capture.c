@@ -0,0 +1,462 @@
+#define _POSIX_C_SOURCE 200809L
+#include "capture.h"
+#include "render.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+    #include <signal.h>
+#endif
+
+#if defined(PLATFORM_WEB)
+
+bool StartCapture(const char* target, int fps) {
+    (void)target;
+    (void)fps;
+    TraceLog(LOG_WARNING, "ASTEROIDS: Video capture is not available in the browser");
+    return false;
+}
+
+void StopCapture(void) {
+}
+
+bool IsCapturing(void) {
+    return false;
+}
+
+void CaptureFrame(void) {
+}
+
+uint64_t GetCapturedFrameCount(void) {
+    return 0;
+}
+
+uint64_t GetDroppedFrameCount(void) {
+    return 0;
+}
+
+#else
+
+// Double-buffered: one buffer fills while the writer drains the other
+#define CAPTURE_BUFFER_COUNT 2
+#define CAPTURE_STREAM_BUFFER (1 << 20)
+
+// rlgl has no pixel pack buffers, so the few GL 3.x calls capture needs are
+// loaded through GLFW, which raylib's desktop build links in
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#define GL_STREAM_READ 0x88E1
+#define GL_MAP_READ_BIT 0x0001
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#define GL_RGBA 0x1908
+#define GL_UNSIGNED_BYTE 0x1401
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_FLUSH_TIMEOUT 1000000000ull
+
+typedef struct GLSyncObject* GLSync;
+typedef void (*GLProc)(void);
+
+extern GLProc glfwGetProcAddress(const char* name);
+
+typedef struct {
+    void (*GenBuffers)(int count, unsigned int* buffers);
+    void (*DeleteBuffers)(int count, const unsigned int* buffers);
+    void (*BindBuffer)(unsigned int target, unsigned int buffer);
+    void (*BufferData)(unsigned int target, ptrdiff_t size, const void* data, unsigned int usage);
+    void* (*MapBufferRange)(unsigned int target, ptrdiff_t offset, ptrdiff_t length, unsigned int access);
+    unsigned char (*UnmapBuffer)(unsigned int target);
+    void (*BindFramebuffer)(unsigned int target, unsigned int framebuffer);
+    void (*ReadPixels)(int x, int y, int width, int height, unsigned int format, unsigned int type, void* pixels);
+    GLSync (*FenceSync)(unsigned int condition, unsigned int flags);
+    unsigned int (*ClientWaitSync)(GLSync sync, unsigned int flags, uint64_t timeout);
+    void (*DeleteSync)(GLSync sync);
+} CaptureGL;
+
+// FREE -> READING (readback queued) -> MAPPED (handed to the writer) ->
+// WRITTEN (writer done) -> FREE once the frame thread unmaps it
+typedef enum {
+    CAPTURE_SLOT_FREE,
+    CAPTURE_SLOT_READING,
+    CAPTURE_SLOT_MAPPED,
+    CAPTURE_SLOT_WRITTEN
+} CaptureSlotState;
+
+typedef struct {
+    unsigned int buffer;
+    GLSync fence;
+    const unsigned char* pixels;
+    uint64_t frame;
+    atomic_int state;
+} CaptureSlot;
+
+typedef struct {
+    bool active;
+    CaptureGL gl;
+    CaptureSlot slots[CAPTURE_BUFFER_COUNT];
+    int sourceWidth;
+    int sourceHeight;
+    int width;
+    int height;
+    uint64_t nextFrame;
+    
+    FILE* out;
+    bool piped;
+    unsigned char* planes;
+    atomic_bool failed;
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool quit;
+    
+    atomic_uint_fast64_t captured;
+    uint64_t dropped;
+    uint64_t repeated;
+    double frameTime;
+    double frameWorst;
+    uint64_t frameCalls;
+} Capture;
+
+static Capture capture = { 0 };
+
+static bool LoadCaptureGL(CaptureGL* gl) {
+#define LOAD(name) \
+    if (!(gl->name = (typeof(gl->name))glfwGetProcAddress("gl" #name))) return false
+    LOAD(GenBuffers);
+    LOAD(DeleteBuffers);
+    LOAD(BindBuffer);
+    LOAD(BufferData);
+    LOAD(MapBufferRange);
+    LOAD(UnmapBuffer);
+    LOAD(BindFramebuffer);
+    LOAD(ReadPixels);
+    LOAD(FenceSync);
+    LOAD(ClientWaitSync);
+    LOAD(DeleteSync);
+#undef LOAD
+    return true;
+}
+
+static inline unsigned char ClampByte(int value) {
+    return (unsigned char)(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+// Full-range BT.601 in 8-bit fixed point, chroma averaged over each 2x2
+// block. GL rows run bottom to top, so the source is read upside down.
+static void ConvertToI420(const unsigned char* rgba, int sourceHeight, int stride, int width, int height,
+                          unsigned char* planes) {
+    unsigned char* lumaPlane = planes;
+    unsigned char* uPlane = planes + width * height;
+    unsigned char* vPlane = uPlane + (width / 2) * (height / 2);
+    
+    for (int y = 0; y < height; y += 2) {
+        const unsigned char* top = rgba + (size_t)(sourceHeight - 1 - y) * stride;
+        const unsigned char* bottom = top - stride;
+        unsigned char* lumaTop = lumaPlane + (size_t)y * width;
+        unsigned char* lumaBottom = lumaTop + width;
+        unsigned char* u = uPlane + (size_t)(y / 2) * (width / 2);
+        unsigned char* v = vPlane + (size_t)(y / 2) * (width / 2);
+        
+        for (int x = 0; x < width; x += 2) {
+            int r = 0, g = 0, b = 0;
+            const unsigned char* block[4] = { top + x * 4, top + x * 4 + 4, bottom + x * 4, bottom + x * 4 + 4 };
+            unsigned char* luma[4] = { lumaTop + x, lumaTop + x + 1, lumaBottom + x, lumaBottom + x + 1 };
+            
+            for (int k = 0; k < 4; k++) {
+                int pr = block[k][0], pg = block[k][1], pb = block[k][2];
+                *luma[k] = (unsigned char)((77 * pr + 150 * pg + 29 * pb + 128) >> 8);
+                r += pr;
+                g += pg;
+                b += pb;
+            }
+            
+            *u = ClampByte(((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128);
+            *v = ClampByte(((128 * r - 107 * g - 21 * b + 512) >> 10) + 128);
+            u++;
+            v++;
+        }
+    }
+}
+
+static CaptureSlot* NextMappedSlot(void) {
+    CaptureSlot* oldest = nullptr;
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++) {
+        CaptureSlot* slot = &capture.slots[i];
+        if (atomic_load_explicit(&slot->state, memory_order_acquire) != CAPTURE_SLOT_MAPPED) continue;
+        if (!oldest || slot->frame < oldest->frame) oldest = slot;
+    }
+    return oldest;
+}
+
+static bool WriteFramePlanes(size_t frameBytes) {
+    return fputs("FRAME\n", capture.out) >= 0 && fwrite(capture.planes, 1, frameBytes, capture.out) == frameBytes;
+}
+
+// Repeats the frame in the planes until the stream holds `until` frames
+static void PadStream(uint64_t* streamFrames, uint64_t until, size_t frameBytes) {
+    for (; *streamFrames < until && !atomic_load_explicit(&capture.failed, memory_order_relaxed); (*streamFrames)++) {
+        if (!WriteFramePlanes(frameBytes)) {
+            atomic_store_explicit(&capture.failed, true, memory_order_relaxed);
+        } else {
+            capture.repeated++;
+        }
+    }
+}
+
+// Converts and writes frames in order, straight out of the mapped buffers.
+// Every CaptureFrame call owns a frame number, dropped or not, and the Y4M
+// header promises a fixed rate, so gaps are filled by holding the previous
+// frame; the stream stays as long as the session it recorded.
+static void* CaptureWriter(void* arg) {
+    (void)arg;
+    size_t frameBytes = (size_t)capture.width * capture.height * 3 / 2;
+    uint64_t streamFrames = 0;
+    
+    for (;;) {
+        pthread_mutex_lock(&capture.lock);
+        CaptureSlot* slot;
+        while (!(slot = NextMappedSlot()) && !capture.quit) {
+            pthread_cond_wait(&capture.wake, &capture.lock);
+        }
+        // Without a slot the session is over and the frame thread no longer numbers frames
+        uint64_t sessionFrames = slot ? 0 : capture.nextFrame;
+        pthread_mutex_unlock(&capture.lock);
+        if (!slot) {
+            // Frames dropped after the last one written still take up time
+            if (streamFrames > 0) PadStream(&streamFrames, sessionFrames, frameBytes);
+            break;
+        }
+        
+        if (!atomic_load_explicit(&capture.failed, memory_order_relaxed)) {
+            if (streamFrames > 0) PadStream(&streamFrames, slot->frame, frameBytes);
+            ConvertToI420(slot->pixels, capture.sourceHeight, capture.sourceWidth * 4,
+                          capture.width, capture.height, capture.planes);
+            if (!WriteFramePlanes(frameBytes)) {
+                atomic_store_explicit(&capture.failed, true, memory_order_relaxed);
+            } else {
+                atomic_fetch_add_explicit(&capture.captured, 1, memory_order_relaxed);
+                streamFrames++;
+                // Drops before the first frame are covered by that frame
+                PadStream(&streamFrames, slot->frame + 1, frameBytes);
+            }
+        }
+        atomic_store_explicit(&slot->state, CAPTURE_SLOT_WRITTEN, memory_order_release);
+    }
+    return nullptr;
+}
+
+static void HandToWriter(CaptureSlot* slot) {
+    capture.gl.DeleteSync(slot->fence);
+    slot->fence = nullptr;
+    
+    capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+    slot->pixels = capture.gl.MapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                             (ptrdiff_t)capture.sourceWidth * capture.sourceHeight * 4, GL_MAP_READ_BIT);
+    if (!slot->pixels) {
+        atomic_store_explicit(&slot->state, CAPTURE_SLOT_FREE, memory_order_relaxed);
+        capture.dropped++;
+        return;
+    }
+    
+    pthread_mutex_lock(&capture.lock);
+    atomic_store_explicit(&slot->state, CAPTURE_SLOT_MAPPED, memory_order_release);
+    pthread_cond_signal(&capture.wake);
+    pthread_mutex_unlock(&capture.lock);
+}
+
+// Maps finished readbacks oldest first; with wait set it blocks on the GPU,
+// which only StopCapture does
+static void CollectReadbacks(bool wait) {
+    for (;;) {
+        CaptureSlot* oldest = nullptr;
+        for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++) {
+            CaptureSlot* slot = &capture.slots[i];
+            if (atomic_load_explicit(&slot->state, memory_order_relaxed) != CAPTURE_SLOT_READING) continue;
+            if (!oldest || slot->frame < oldest->frame) oldest = slot;
+        }
+        if (!oldest) return;
+        
+        unsigned int status = capture.gl.ClientWaitSync(oldest->fence, 0, wait ? GL_FLUSH_TIMEOUT : 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return;
+        HandToWriter(oldest);
+    }
+}
+
+static void ReclaimWrittenSlots(void) {
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++) {
+        CaptureSlot* slot = &capture.slots[i];
+        if (atomic_load_explicit(&slot->state, memory_order_acquire) != CAPTURE_SLOT_WRITTEN) continue;
+        capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+        capture.gl.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        slot->pixels = nullptr;
+        atomic_store_explicit(&slot->state, CAPTURE_SLOT_FREE, memory_order_relaxed);
+    }
+}
+
+static void QueueReadback(void) {
+    int width, height;
+    unsigned int framebuffer = GetScaledFramebuffer(&width, &height);
+    if (width != capture.sourceWidth || height != capture.sourceHeight) {
+        capture.dropped++;
+        capture.nextFrame++;
+        return;
+    }
+    
+    CaptureSlot* slot = nullptr;
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT && !slot; i++) {
+        if (atomic_load_explicit(&capture.slots[i].state, memory_order_relaxed) == CAPTURE_SLOT_FREE) {
+            slot = &capture.slots[i];
+        }
+    }
+    if (!slot) {
+        capture.dropped++;
+        capture.nextFrame++;
+        return;
+    }
+    
+    capture.gl.BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+    capture.gl.ReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    capture.gl.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    slot->fence = capture.gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->frame = capture.nextFrame++;
+    atomic_store_explicit(&slot->state, CAPTURE_SLOT_READING, memory_order_relaxed);
+}
+
+bool StartCapture(const char* target, int fps) {
+    if (capture.active) return true;
+    
+    int version = rlGetVersion();
+    if ((version != RL_OPENGL_33 && version != RL_OPENGL_43) || !LoadCaptureGL(&capture.gl)) {
+        TraceLog(LOG_WARNING, "ASTEROIDS: Video capture needs OpenGL 3.3");
+        return false;
+    }
+    
+    GetScaledFramebuffer(&capture.sourceWidth, &capture.sourceHeight);
+    capture.width = capture.sourceWidth & ~1;
+    capture.height = capture.sourceHeight & ~1;
+    capture.planes = malloc((size_t)capture.width * capture.height * 3 / 2);
+    if (!capture.planes) return false;
+    
+    capture.piped = (target[0] == '|');
+    if (capture.piped) {
+        // A dying encoder should fail the writes, not kill the game
+        signal(SIGPIPE, SIG_IGN);
+        capture.out = popen(target + 1, "w");
+    } else {
+        capture.out = fopen(target, "wb");
+    }
+    if (!capture.out) {
+        fprintf(stderr, "Failed to open capture output: %s\n", target);
+        free(capture.planes);
+        capture.planes = nullptr;
+        return false;
+    }
+    setvbuf(capture.out, nullptr, _IOFBF, CAPTURE_STREAM_BUFFER);
+    fprintf(capture.out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", capture.width, capture.height, fps);
+    
+    size_t bytes = (size_t)capture.sourceWidth * capture.sourceHeight * 4;
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++) {
+        CaptureSlot* slot = &capture.slots[i];
+        capture.gl.GenBuffers(1, &slot->buffer);
+        capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+        capture.gl.BufferData(GL_PIXEL_PACK_BUFFER, (ptrdiff_t)bytes, nullptr, GL_STREAM_READ);
+        atomic_init(&slot->state, CAPTURE_SLOT_FREE);
+    }
+    capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    capture.nextFrame = 0;
+    capture.dropped = 0;
+    capture.repeated = 0;
+    capture.frameTime = 0;
+    capture.frameWorst = 0;
+    capture.frameCalls = 0;
+    capture.quit = false;
+    atomic_init(&capture.captured, 0);
+    atomic_init(&capture.failed, false);
+    pthread_mutex_init(&capture.lock, nullptr);
+    pthread_cond_init(&capture.wake, nullptr);
+    if (pthread_create(&capture.writer, nullptr, CaptureWriter, nullptr) != 0) {
+        capture.piped ? pclose(capture.out) : fclose(capture.out);
+        free(capture.planes);
+        capture.planes = nullptr;
+        return false;
+    }
+    
+    capture.active = true;
+    TraceLog(LOG_INFO, "ASTEROIDS: Capturing %dx%d at %d FPS", capture.width, capture.height, fps);
+    return true;
+}
+
+void CaptureFrame(void) {
+    if (!capture.active) return;
+    double start = GetTime();
+    
+    ReclaimWrittenSlots();
+    CollectReadbacks(false);
+    QueueReadback();
+    capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    double elapsed = GetTime() - start;
+    capture.frameTime += elapsed;
+    capture.frameCalls++;
+    if (elapsed > capture.frameWorst) capture.frameWorst = elapsed;
+}
+
+// Finishes the readbacks in flight, lets the writer drain them, then closes the stream
+void StopCapture(void) {
+    if (!capture.active) return;
+    capture.active = false;
+    
+    CollectReadbacks(true);
+    pthread_mutex_lock(&capture.lock);
+    capture.quit = true;
+    pthread_cond_signal(&capture.wake);
+    pthread_mutex_unlock(&capture.lock);
+    pthread_join(capture.writer, nullptr);
+    
+    ReclaimWrittenSlots();
+    for (int i = 0; i < CAPTURE_BUFFER_COUNT; i++) {
+        CaptureSlot* slot = &capture.slots[i];
+        if (slot->fence) capture.gl.DeleteSync(slot->fence);
+        slot->fence = nullptr;
+        capture.gl.DeleteBuffers(1, &slot->buffer);
+    }
+    capture.gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pthread_mutex_destroy(&capture.lock);
+    pthread_cond_destroy(&capture.wake);
+    
+    int status = capture.piped ? pclose(capture.out) : fclose(capture.out);
+    capture.out = nullptr;
+    free(capture.planes);
+    capture.planes = nullptr;
+    
+    if (atomic_load(&capture.failed) || status != 0) {
+        fprintf(stderr, "Capture output failed; the video is incomplete\n");
+    }
+    TraceLog(LOG_INFO, "ASTEROIDS: Captured %llu frames, dropped %llu (%llu repeats written in their place), "
+             "frame thread %.3f ms average, %.3f ms worst",
+             (unsigned long long)atomic_load(&capture.captured), (unsigned long long)capture.dropped,
+             (unsigned long long)capture.repeated,
+             capture.frameCalls ? capture.frameTime / capture.frameCalls * 1000.0 : 0.0, capture.frameWorst * 1000.0);
+}
+
+bool IsCapturing(void) {
+    return capture.active;
+}
+
+uint64_t GetCapturedFrameCount(void) {
+    return atomic_load_explicit(&capture.captured, memory_order_relaxed);
+}
+
+uint64_t GetDroppedFrameCount(void) {
+    return capture.dropped;
+}
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// In-engine video capture. Each frame's offscreen render target is read back
+// into one of CAPTURE_BUFFER_COUNT pixel buffers without waiting for the GPU.
+// A later frame maps the finished buffer, and a writer thread converts it to
+// 4:2:0 YUV and streams it out as YUV4MPEG2. The frame thread never waits:
+// when no buffer is free the frame is dropped and counted, and the writer
+// repeats the previous frame in its place so the video keeps real time.
+//
+// The target is a .y4m path, or "|command" to pipe the stream into an
+// encoder, e.g. "|ffmpeg -y -i - -c:v libx264 session.mp4". Desktop only.
+
+bool StartCapture(const char* target, int fps);
+void StopCapture(void);
+bool IsCapturing(void);
+
+// Call once per frame after the scaled frame has been drawn
+void CaptureFrame(void);
+
+uint64_t GetCapturedFrameCount(void);
+uint64_t GetDroppedFrameCount(void);
+
+#endif
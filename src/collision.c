@@ -0,0 +1,168 @@
+#include "collision.h"
+
+#define OUTLINE_CACHE_SETS 64
+#define OUTLINE_CACHE_WAYS 4
+
+// Rotated outlines of recent narrowphase candidates, tagged with their slot.
+// An entry is valid while the asteroid's shape, size, rotation and position
+// are unchanged, which holds for the rest of the tick, so several bullets
+// probing one asteroid rotate its outline once. Sets are several ways deep so
+// swarm slots that share a set do not evict each other within a tick.
+// Per thread because lookahead rollouts collide in parallel.
+typedef struct {
+    int slot;
+    int shapeIndex;
+    float radius;
+    float rotation;
+    Vector2 position;
+    int pointCount;
+    Vector2 points[MAX_ASTEROID_VERTICES];
+} CachedOutline;
+
+typedef struct {
+    CachedOutline ways[OUTLINE_CACHE_WAYS];
+    int victim;
+} OutlineCacheSet;
+
+static thread_local OutlineCacheSet outlineCache[OUTLINE_CACHE_SETS];
+
+static const CachedOutline* GetCachedOutline(const Asteroid* asteroid, int index) {
+    OutlineCacheSet* set = &outlineCache[index % OUTLINE_CACHE_SETS];
+    
+    CachedOutline* entry = nullptr;
+    for (int way = 0; way < OUTLINE_CACHE_WAYS; way++) {
+        if (set->ways[way].pointCount > 0 && set->ways[way].slot == index) {
+            entry = &set->ways[way];
+            break;
+        }
+    }
+    if (!entry) {
+        entry = &set->ways[set->victim];
+        set->victim = (set->victim + 1) % OUTLINE_CACHE_WAYS;
+        entry->slot = index;
+        entry->pointCount = 0;
+    }
+    
+    if (entry->pointCount == 0 ||
+        entry->shapeIndex != asteroid->shapeIndex ||
+        entry->radius != asteroid->radius ||
+        entry->rotation != asteroid->rotation ||
+        entry->position.x != asteroid->position.x ||
+        entry->position.y != asteroid->position.y) {
+        entry->shapeIndex = asteroid->shapeIndex;
+        entry->radius = asteroid->radius;
+        entry->rotation = asteroid->rotation;
+        entry->position = asteroid->position;
+        entry->pointCount = GetAsteroidOutline(asteroid, entry->points);
+    }
+    
+    return entry;
+}
+
+// Crossing-number test; outlines are star-shaped but not always convex
+static bool IsPointInOutline(const Vector2* points, int pointCount, Vector2 point) {
+    bool inside = false;
+    
+    for (int i = 0, j = pointCount - 1; i < pointCount; j = i++) {
+        Vector2 a = points[i];
+        Vector2 b = points[j];
+        if ((a.y > point.y) != (b.y > point.y) &&
+            point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    
+    return inside;
+}
+
+static float SegmentDistanceSquared(Vector2 a, Vector2 b, Vector2 point) {
+    float abx = b.x - a.x;
+    float aby = b.y - a.y;
+    float apx = point.x - a.x;
+    float apy = point.y - a.y;
+    float lengthSquared = abx * abx + aby * aby;
+    
+    float t = (lengthSquared > 0) ? (apx * abx + apy * aby) / lengthSquared : 0;
+    if (t < 0) t = 0;
+    if (t > 1) t = 1;
+    
+    float dx = apx - abx * t;
+    float dy = apy - aby * t;
+    return dx * dx + dy * dy;
+}
+
+static float Cross(Vector2 o, Vector2 a, Vector2 b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+static bool SegmentsIntersect(Vector2 a, Vector2 b, Vector2 c, Vector2 d) {
+    float d1 = Cross(c, d, a);
+    float d2 = Cross(c, d, b);
+    float d3 = Cross(a, b, c);
+    float d4 = Cross(a, b, d);
+    return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+bool CheckCircleOutlineOverlap(const Vector2* points, int pointCount, Vector2 center, float radius) {
+    if (IsPointInOutline(points, pointCount, center)) return true;
+    
+    float radiusSquared = radius * radius;
+    for (int i = 0, j = pointCount - 1; i < pointCount; j = i++) {
+        if (SegmentDistanceSquared(points[j], points[i], center) <= radiusSquared) return true;
+    }
+    
+    return false;
+}
+
+bool CheckTriangleOutlineOverlap(const Vector2 triangle[3], const Vector2* points, int pointCount) {
+    for (int i = 0; i < 3; i++) {
+        if (IsPointInOutline(points, pointCount, triangle[i])) return true;
+    }
+    if (IsPointInOutline(triangle, 3, points[0])) return true;
+    
+    for (int i = 0, j = pointCount - 1; i < pointCount; j = i++) {
+        for (int k = 0; k < 3; k++) {
+            if (SegmentsIntersect(points[j], points[i], triangle[k], triangle[(k + 1) % 3])) return true;
+        }
+    }
+    
+    return false;
+}
+
+// Narrowphase for one candidate that already passed the bounding-circle test.
+// `index` is the asteroid's slot and keys the outline cache.
+bool CheckAsteroidCircleHit(const Asteroid* asteroid, int index, Vector2 center, float radius) {
+    const CachedOutline* outline = GetCachedOutline(asteroid, index);
+    return CheckCircleOutlineOverlap(outline->points, outline->pointCount, center, radius);
+}
+
+bool CheckAsteroidHullHit(const Asteroid* asteroid, int index, const Vector2 hull[3]) {
+    const CachedOutline* outline = GetCachedOutline(asteroid, index);
+    return CheckTriangleOutlineOverlap(hull, outline->points, outline->pointCount);
+}
+
+// First asteroid, in slot order, whose outline overlaps the circle, or -1
+int FindAsteroidHit(const Asteroid* asteroids, int count, Vector2 center, float radius) {
+    for (int i = FindAsteroidOverlap(asteroids, 0, count, center, radius); i >= 0;
+         i = FindAsteroidOverlap(asteroids, i + 1, count, center, radius)) {
+        if (CheckAsteroidCircleHit(&asteroids[i], i, center, radius)) return i;
+    }
+    return -1;
+}
+
+// First asteroid whose outline overlaps the ship's hull, or -1
+int FindShipAsteroidHit(const Asteroid* asteroids, int count, const Spaceship* ship) {
+    Vector2 hull[3];
+    Vector2 flame[3];
+    bool outlined = false;
+    
+    for (int i = FindAsteroidOverlap(asteroids, 0, count, ship->position, SPACESHIP_BOUND_RADIUS); i >= 0;
+         i = FindAsteroidOverlap(asteroids, i + 1, count, ship->position, SPACESHIP_BOUND_RADIUS)) {
+        if (!outlined) {
+            GetSpaceshipOutline(ship, hull, flame);
+            outlined = true;
+        }
+        if (CheckAsteroidHullHit(&asteroids[i], i, hull)) return i;
+    }
+    return -1;
+}
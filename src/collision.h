@@ -0,0 +1,19 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "entities.h"
+
+// Asteroid narrowphase. Bounding circles from FindAsteroidOverlap() filter the
+// candidates, which are then tested exactly against their rotated outlines,
+// so hits follow the jagged shapes rather than a circle of `radius`.
+
+int FindAsteroidHit(const Asteroid* asteroids, int count, Vector2 center, float radius);
+int FindShipAsteroidHit(const Asteroid* asteroids, int count, const Spaceship* ship);
+
+bool CheckAsteroidCircleHit(const Asteroid* asteroid, int index, Vector2 center, float radius);
+bool CheckAsteroidHullHit(const Asteroid* asteroid, int index, const Vector2 hull[3]);
+
+bool CheckCircleOutlineOverlap(const Vector2* points, int pointCount, Vector2 center, float radius);
+bool CheckTriangleOutlineOverlap(const Vector2 triangle[3], const Vector2* points, int pointCount);
+
+#endif
@@ -1,9 +1,140 @@
 #include "entities.h"
 #include "utils.h"
+#include "tuning.h"
+#include "particles.h"
+#include "fixed.h"
 #include "raymath.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+
+// Simulation math goes through these helpers. The default build uses float
+// and libm; FIXED_POINT_PHYSICS routes them through Q16.16 integer math so
+// lockstep peers on different platforms compute bit-identical states.
+// Entity state stays in floats either way: Q16.16 to float conversion is
+// exact rounding, so each step quantizes the same on every target.
+#if defined(FIXED_POINT_PHYSICS)
+
+static Vector2 HeadingVector(float degrees, float length) {
+    Fixed angle = FixedFromFloat(degrees);
+    Fixed scale = FixedFromFloat(length);
+    return (Vector2){
+        FixedToFloat(FixedMul(FixedCosDegrees(angle), scale)),
+        FixedToFloat(FixedMul(FixedSinDegrees(angle), scale))
+    };
+}
+
+float Integrate(float value, float rate, float deltaTime) {
+    return FixedToFloat(FixedFromFloat(value) + FixedMul(FixedFromFloat(rate), FixedFromFloat(deltaTime)));
+}
+
+// Headings stay in [0, 360) so a long spin never leaves the Q16.16 range
+float IntegrateDegrees(float degrees, float rate, float deltaTime) {
+    const Fixed fullTurn = 360 * FIXED_ONE;
+    Fixed heading = (FixedFromFloat(degrees) + FixedMul(FixedFromFloat(rate), FixedFromFloat(deltaTime))) % fullTurn;
+    return FixedToFloat(heading < 0 ? heading + fullTurn : heading);
+}
+
+static Vector2 ScaleVelocity(Vector2 velocity, float factor) {
+    Fixed scale = FixedFromFloat(factor);
+    return (Vector2){
+        FixedToFloat(FixedMul(FixedFromFloat(velocity.x), scale)),
+        FixedToFloat(FixedMul(FixedFromFloat(velocity.y), scale))
+    };
+}
+
+static Vector2 ClampSpeed(Vector2 velocity, float maxSpeed) {
+    Fixed x = FixedFromFloat(velocity.x);
+    Fixed y = FixedFromFloat(velocity.y);
+    Fixed limit = FixedFromFloat(maxSpeed);
+    int64_t lengthSquared = FixedLengthSquared(x, y);
+    if (lengthSquared <= (int64_t)limit * limit) return velocity;
+    
+    Fixed length = FixedSqrtWide(lengthSquared);
+    return (Vector2){
+        FixedToFloat((Fixed)((int64_t)x * limit / length)),
+        FixedToFloat((Fixed)((int64_t)y * limit / length))
+    };
+}
+
+float GetHeadingDegrees(Vector2 direction) {
+    return FixedToFloat(FixedAtan2Degrees(FixedFromFloat(direction.y), FixedFromFloat(direction.x)));
+}
+
+bool CheckCirclesOverlap(Vector2 a, float radiusA, Vector2 b, float radiusB) {
+    Fixed dx = FixedFromFloat(b.x) - FixedFromFloat(a.x);
+    Fixed dy = FixedFromFloat(b.y) - FixedFromFloat(a.y);
+    int64_t reach = (int64_t)FixedFromFloat(radiusA) + FixedFromFloat(radiusB);
+    return FixedLengthSquared(dx, dy) <= reach * reach;
+}
+
+#else
+
+static Vector2 HeadingVector(float degrees, float length) {
+    float radians = degrees * DEG2RAD;
+    return (Vector2){cos(radians) * length, sin(radians) * length};
+}
+
+float Integrate(float value, float rate, float deltaTime) {
+    return value + rate * deltaTime;
+}
+
+// Headings stay in [0, 360) so they keep their precision however long they spin
+float IntegrateDegrees(float degrees, float rate, float deltaTime) {
+    float heading = fmodf(degrees + rate * deltaTime, 360.0f);
+    if (heading < 0) heading += 360.0f;
+    return heading < 360.0f ? heading : 0.0f;
+}
+
+static Vector2 ScaleVelocity(Vector2 velocity, float factor) {
+    return Vector2Scale(velocity, factor);
+}
+
+static Vector2 ClampSpeed(Vector2 velocity, float maxSpeed) {
+    float speed = Vector2Length(velocity);
+    if (speed > maxSpeed) {
+        return Vector2Scale(Vector2Normalize(velocity), maxSpeed);
+    }
+    return velocity;
+}
+
+float GetHeadingDegrees(Vector2 direction) {
+    return atan2f(direction.y, direction.x) * RAD2DEG;
+}
+
+bool CheckCirclesOverlap(Vector2 a, float radiusA, Vector2 b, float radiusB) {
+    return CheckCollisionCircles(a, radiusA, b, radiusB);
+}
+
+#endif
+
+static AsteroidShape asteroidShapes[ASTEROID_SHAPE_TEMPLATES];
+static pthread_once_t asteroidShapesOnce = PTHREAD_ONCE_INIT;
+
+// Templates come from a fixed-seed generator so every session and renderer sees the same atlas
+static void BuildAsteroidShapes(void) {
+    unsigned int seed = 0x2545F491u;
+    
+    for (int s = 0; s < ASTEROID_SHAPE_TEMPLATES; s++) {
+        AsteroidShape* shape = &asteroidShapes[s];
+        seed = seed * 1664525u + 1013904223u;
+        shape->pointCount = 8 + (int)((seed >> 16) % (MAX_ASTEROID_VERTICES - 8 + 1));
+        
+        for (int i = 0; i < shape->pointCount; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            float angleStep = (360.0f / shape->pointCount) * i;
+            float radiusVariation = ASTEROID_SHAPE_MIN_SCALE +
+                (ASTEROID_SHAPE_MAX_SCALE - ASTEROID_SHAPE_MIN_SCALE) * ((seed >> 8) / (float)(1u << 24));
+            shape->points[i] = HeadingVector(angleStep, radiusVariation);
+        }
+    }
+}
+
+const AsteroidShape* GetAsteroidShape(int index) {
+    pthread_once(&asteroidShapesOnce, BuildAsteroidShapes);
+    return &asteroidShapes[index];
+}
 
 void InitSpaceship(Spaceship* ship, float x, float y) {
     ship->position = (Vector2){x, y};
@@ -12,7 +143,7 @@ void InitSpaceship(Spaceship* ship, float x, float y) {
     ship->rotationSpeed = 0;
     ship->isThrusting = false;
     ship->isAlive = true;
-    ship->invulnerableTime = SPACESHIP_INVULNERABLE_TIME;
+    ship->isInvulnerable = true;
     ship->lives = 3;
 }
 
@@ -23,97 +154,89 @@ void RespawnSpaceship(Spaceship* ship, float x, float y) {
     ship->rotationSpeed = 0;
     ship->isThrusting = false;
     ship->isAlive = true;
-    ship->invulnerableTime = SPACESHIP_INVULNERABLE_TIME;
+    ship->isInvulnerable = true;
     // Don't reset lives - keep the current value
 }
 
 void UpdateSpaceship(Spaceship* ship, float deltaTime) {
     if (!ship->isAlive) return;
     
-    ship->rotation += ship->rotationSpeed * deltaTime;
+    ship->rotation = IntegrateDegrees(ship->rotation, ship->rotationSpeed, deltaTime);
     
     if (ship->isThrusting) {
-        float radians = (ship->rotation - 90) * DEG2RAD;
-        ship->velocity.x += cos(radians) * SPACESHIP_THRUST_POWER * deltaTime;
-        ship->velocity.y += sin(radians) * SPACESHIP_THRUST_POWER * deltaTime;
-        
-        float speed = Vector2Length(ship->velocity);
-        if (speed > SPACESHIP_MAX_SPEED) {
-            ship->velocity = Vector2Scale(Vector2Normalize(ship->velocity), SPACESHIP_MAX_SPEED);
-        }
+        Vector2 thrust = HeadingVector(ship->rotation - 90, tuning->shipThrustPower);
+        ship->velocity.x = Integrate(ship->velocity.x, thrust.x, deltaTime);
+        ship->velocity.y = Integrate(ship->velocity.y, thrust.y, deltaTime);
+        ship->velocity = ClampSpeed(ship->velocity, tuning->shipMaxSpeed);
     }
     
-    ship->velocity = Vector2Scale(ship->velocity, SPACESHIP_DRAG);
-    
-    ship->position.x += ship->velocity.x * deltaTime;
-    ship->position.y += ship->velocity.y * deltaTime;
+    ship->velocity = ScaleVelocity(ship->velocity, tuning->shipDrag);
     
-    if (ship->invulnerableTime > 0) {
-        ship->invulnerableTime -= deltaTime;
-    }
+    ship->position.x = Integrate(ship->position.x, ship->velocity.x, deltaTime);
+    ship->position.y = Integrate(ship->position.y, ship->velocity.y, deltaTime);
 }
 
-void DrawSpaceship(const Spaceship* ship) {
-    if (!ship->isAlive) return;
+bool IsSpaceshipVisible(const Spaceship* ship, float invulnerableTime) {
+    if (!ship->isAlive) return false;
     
+    // Blink while invulnerable
     if (IsSpaceshipInvulnerable(ship)) {
-        if ((int)(ship->invulnerableTime * 10) % 2 == 0) return;
+        if ((int)(invulnerableTime * 10) % 2 == 0) return false;
     }
+    return true;
+}
+
+void GetSpaceshipOutline(const Spaceship* ship, Vector2 hull[3], Vector2 flame[3]) {
+    const Vector2 local[6] = {
+        {0, -SPACESHIP_SIZE},
+        {-SPACESHIP_SIZE * 0.7f, SPACESHIP_SIZE},
+        {SPACESHIP_SIZE * 0.7f, SPACESHIP_SIZE},
+        {-SPACESHIP_SIZE * 0.4f, SPACESHIP_SIZE},
+        {0, SPACESHIP_SIZE * 1.5f},
+        {SPACESHIP_SIZE * 0.4f, SPACESHIP_SIZE}
+    };
     
-    Vector2 v1 = {0, -SPACESHIP_SIZE};
-    Vector2 v2 = {-SPACESHIP_SIZE * 0.7f, SPACESHIP_SIZE};
-    Vector2 v3 = {SPACESHIP_SIZE * 0.7f, SPACESHIP_SIZE};
+    Vector2 axis = HeadingVector(ship->rotation, 1.0f);
+    float cosR = axis.x;
+    float sinR = axis.y;
     
-    float radians = ship->rotation * DEG2RAD;
-    float cosR = cos(radians);
-    float sinR = sin(radians);
+    for (int i = 0; i < 6; i++) {
+        Vector2 p = {
+            local[i].x * cosR - local[i].y * sinR + ship->position.x,
+            local[i].x * sinR + local[i].y * cosR + ship->position.y
+        };
+        if (i < 3) {
+            hull[i] = p;
+        } else {
+            flame[i - 3] = p;
+        }
+    }
+}
+
+void DrawSpaceship(const Spaceship* ship, float invulnerableTime) {
+    if (!IsSpaceshipVisible(ship, invulnerableTime)) return;
     
-    Vector2 tv1 = {
-        v1.x * cosR - v1.y * sinR + ship->position.x,
-        v1.x * sinR + v1.y * cosR + ship->position.y
-    };
-    Vector2 tv2 = {
-        v2.x * cosR - v2.y * sinR + ship->position.x,
-        v2.x * sinR + v2.y * cosR + ship->position.y
-    };
-    Vector2 tv3 = {
-        v3.x * cosR - v3.y * sinR + ship->position.x,
-        v3.x * sinR + v3.y * cosR + ship->position.y
-    };
+    Vector2 hull[3];
+    Vector2 flame[3];
+    GetSpaceshipOutline(ship, hull, flame);
     
-    DrawLineV(tv1, tv2, WHITE);
-    DrawLineV(tv2, tv3, WHITE);
-    DrawLineV(tv3, tv1, WHITE);
+    DrawLineV(hull[0], hull[1], WHITE);
+    DrawLineV(hull[1], hull[2], WHITE);
+    DrawLineV(hull[2], hull[0], WHITE);
     
     if (ship->isThrusting) {
-        Vector2 thrust1 = {-SPACESHIP_SIZE * 0.4f, SPACESHIP_SIZE};
-        Vector2 thrust2 = {0, SPACESHIP_SIZE * 1.5f};
-        Vector2 thrust3 = {SPACESHIP_SIZE * 0.4f, SPACESHIP_SIZE};
-        
-        Vector2 tt1 = {
-            thrust1.x * cosR - thrust1.y * sinR + ship->position.x,
-            thrust1.x * sinR + thrust1.y * cosR + ship->position.y
-        };
-        Vector2 tt2 = {
-            thrust2.x * cosR - thrust2.y * sinR + ship->position.x,
-            thrust2.x * sinR + thrust2.y * cosR + ship->position.y
-        };
-        Vector2 tt3 = {
-            thrust3.x * cosR - thrust3.y * sinR + ship->position.x,
-            thrust3.x * sinR + thrust3.y * cosR + ship->position.y
-        };
-        
-        DrawLineV(tt1, tt2, ORANGE);
-        DrawLineV(tt2, tt3, ORANGE);
+        DrawLineV(flame[0], flame[1], ORANGE);
+        DrawLineV(flame[1], flame[2], ORANGE);
     }
 }
 
 void ThrustSpaceship(Spaceship* ship) {
     ship->isThrusting = true;
+    EmitThrustParticles(ship->position, ship->rotation, ship->velocity);
 }
 
 void RotateSpaceship(Spaceship* ship, float direction) {
-    ship->rotationSpeed = direction * SPACESHIP_ROTATION_SPEED;
+    ship->rotationSpeed = direction * tuning->shipRotationSpeed;
 }
 
 void HyperspaceJump(Spaceship* ship, float screenWidth, float screenHeight) {
@@ -123,7 +246,7 @@ void HyperspaceJump(Spaceship* ship, float screenWidth, float screenHeight) {
 }
 
 bool IsSpaceshipInvulnerable(const Spaceship* ship) {
-    return ship->invulnerableTime > 0;
+    return ship->isInvulnerable;
 }
 
 void InitAsteroid(Asteroid* asteroid, float x, float y, AsteroidSize size) {
@@ -131,71 +254,110 @@ void InitAsteroid(Asteroid* asteroid, float x, float y, AsteroidSize size) {
     asteroid->size = size;
     asteroid->isActive = true;
     
-    switch(size) {
-        case ASTEROID_LARGE:
-            asteroid->radius = ASTEROID_LARGE_RADIUS;
-            break;
-        case ASTEROID_MEDIUM:
-            asteroid->radius = ASTEROID_MEDIUM_RADIUS;
-            break;
-        case ASTEROID_SMALL:
-            asteroid->radius = ASTEROID_SMALL_RADIUS;
-            break;
-    }
+    asteroid->radius = GetAsteroidRadius(size);
     
-    float speed = RandomFloat(ASTEROID_SPEED_MIN, ASTEROID_SPEED_MAX);
-    float angle = RandomFloat(0, 360) * DEG2RAD;
-    asteroid->velocity = (Vector2){cos(angle) * speed, sin(angle) * speed};
+    float speed = RandomFloat(tuning->asteroidSpeedMin, tuning->asteroidSpeedMax);
+    asteroid->velocity = HeadingVector(RandomFloat(0, 360), speed);
     
     asteroid->rotation = RandomFloat(0, 360);
     asteroid->rotationSpeed = RandomFloat(-100, 100);
     
-    asteroid->shapePointCount = RandomInt(8, MAX_ASTEROID_VERTICES);
-    asteroid->shape = malloc(sizeof(Vector2) * asteroid->shapePointCount);
+    asteroid->shapeIndex = RandomInt(0, ASTEROID_SHAPE_TEMPLATES - 1);
+}
+
+// Moving kinds advanced by generated batch kernels: X(Name, Type, spins, expires).
+// Inactive slots are stepped by zero instead of skipped, so each kernel's loop
+// body has no data-dependent branches and the per-kind flags fold away.
+#define MOVER_KIND_TABLE(X) \
+    X(Asteroid, Asteroid, 1, 0) \
+    X(Bullet, Bullet, 0, 1)
+
+#define MOVER_SPIN_0(item, step)
+#define MOVER_SPIN_1(item, step) \
+    (item)->rotation = IntegrateDegrees((item)->rotation, (item)->rotationSpeed, step);
+
+#define MOVER_EXPIRE_0(item, step)
+#define MOVER_EXPIRE_1(item, step) \
+    (item)->lifetime -= step; \
+    (item)->isActive = (item)->isActive & ((item)->lifetime > 0);
+
+#define DEFINE_MOVER_KERNEL(Name, Type, spins, expires) \
+    void Update##Name##s(Type* items, int count, float deltaTime, float screenWidth, float screenHeight) { \
+        for (int i = 0; i < count; i++) { \
+            Type* item = &items[i]; \
+            float step = item->isActive ? deltaTime : 0.0f; \
+            item->position.x = Integrate(item->position.x, item->velocity.x, step); \
+            item->position.y = Integrate(item->position.y, item->velocity.y, step); \
+            MOVER_SPIN_##spins(item, step) \
+            MOVER_EXPIRE_##expires(item, step) \
+            WrapPosition(&item->position, screenWidth, screenHeight); \
+        } \
+    }
+
+MOVER_KIND_TABLE(DEFINE_MOVER_KERNEL)
+
+// First active asteroid from `first` on whose bounding circle overlaps the
+// circle, or -1. The reach for each size is computed once per call, leaving
+// one compare per slot in the scan.
+int FindAsteroidOverlap(const Asteroid* asteroids, int first, int count, Vector2 center, float radius) {
+#if defined(FIXED_POINT_PHYSICS)
+    Fixed cx = FixedFromFloat(center.x);
+    Fixed cy = FixedFromFloat(center.y);
+    int64_t reachSquared[ASTEROID_SIZE_COUNT];
+    for (int s = 0; s < ASTEROID_SIZE_COUNT; s++) {
+        int64_t reach = (int64_t)FixedFromFloat(GetAsteroidRadius(s) * ASTEROID_SHAPE_MAX_SCALE) + FixedFromFloat(radius);
+        reachSquared[s] = reach * reach;
+    }
     
-    for (int i = 0; i < asteroid->shapePointCount; i++) {
-        float angleStep = (360.0f / asteroid->shapePointCount) * i * DEG2RAD;
-        float radiusVariation = RandomFloat(0.8f, 1.2f);
-        asteroid->shape[i] = (Vector2){
-            cos(angleStep) * asteroid->radius * radiusVariation,
-            sin(angleStep) * asteroid->radius * radiusVariation
-        };
+    for (int i = first; i < count; i++) {
+        const Asteroid* asteroid = &asteroids[i];
+        Fixed dx = FixedFromFloat(asteroid->position.x) - cx;
+        Fixed dy = FixedFromFloat(asteroid->position.y) - cy;
+        if (asteroid->isActive & (FixedLengthSquared(dx, dy) <= reachSquared[asteroid->size])) return i;
+    }
+#else
+    float reachSquared[ASTEROID_SIZE_COUNT];
+    for (int s = 0; s < ASTEROID_SIZE_COUNT; s++) {
+        float reach = GetAsteroidRadius(s) * ASTEROID_SHAPE_MAX_SCALE + radius;
+        reachSquared[s] = reach * reach;
+    }
+    
+    for (int i = first; i < count; i++) {
+        const Asteroid* asteroid = &asteroids[i];
+        float dx = asteroid->position.x - center.x;
+        float dy = asteroid->position.y - center.y;
+        if (asteroid->isActive & (dx * dx + dy * dy <= reachSquared[asteroid->size])) return i;
     }
+#endif
+    return -1;
 }
 
-void UpdateAsteroid(Asteroid* asteroid, float deltaTime, float screenWidth, float screenHeight) {
-    if (!asteroid->isActive) return;
-    
-    asteroid->position.x += asteroid->velocity.x * deltaTime;
-    asteroid->position.y += asteroid->velocity.y * deltaTime;
-    asteroid->rotation += asteroid->rotationSpeed * deltaTime;
+int GetAsteroidOutline(const Asteroid* asteroid, Vector2* points) {
+    const AsteroidShape* shape = GetAsteroidShape(asteroid->shapeIndex);
+    
+    Vector2 axis = HeadingVector(asteroid->rotation, asteroid->radius);
+    float cosR = axis.x;
+    float sinR = axis.y;
+    
+    for (int i = 0; i < shape->pointCount; i++) {
+        Vector2 p = shape->points[i];
+        points[i] = (Vector2){
+            p.x * cosR - p.y * sinR + asteroid->position.x,
+            p.x * sinR + p.y * cosR + asteroid->position.y
+        };
+    }
     
-    WrapPosition(&asteroid->position, screenWidth, screenHeight);
+    return shape->pointCount;
 }
 
 void DrawAsteroid(const Asteroid* asteroid) {
-    if (!asteroid->isActive || !asteroid->shape) return;
+    if (!asteroid->isActive) return;
     
-    float radians = asteroid->rotation * DEG2RAD;
-    float cosR = cos(radians);
-    float sinR = sin(radians);
+    Vector2 points[MAX_ASTEROID_VERTICES];
+    int count = GetAsteroidOutline(asteroid, points);
     
-    for (int i = 0; i < asteroid->shapePointCount; i++) {
-        int next = (i + 1) % asteroid->shapePointCount;
-        
-        Vector2 p1 = asteroid->shape[i];
-        Vector2 p2 = asteroid->shape[next];
-        
-        Vector2 tp1 = {
-            p1.x * cosR - p1.y * sinR + asteroid->position.x,
-            p1.x * sinR + p1.y * cosR + asteroid->position.y
-        };
-        Vector2 tp2 = {
-            p2.x * cosR - p2.y * sinR + asteroid->position.x,
-            p2.x * sinR + p2.y * cosR + asteroid->position.y
-        };
-        
-        DrawLineV(tp1, tp2, WHITE);
+    for (int i = 0; i < count; i++) {
+        DrawLineV(points[i], points[(i + 1) % count], WHITE);
     }
 }
 
@@ -207,47 +369,25 @@ void SplitAsteroid(const Asteroid* parent, Asteroid* child1, Asteroid* child2) {
     InitAsteroid(child1, parent->position.x, parent->position.y, newSize);
     InitAsteroid(child2, parent->position.x, parent->position.y, newSize);
     
-    float angle1 = RandomFloat(0, 360) * DEG2RAD;
-    float angle2 = angle1 + PI;
-    float speed = RandomFloat(ASTEROID_SPEED_MIN * 1.5f, ASTEROID_SPEED_MAX * 1.5f);
+    float angle1 = RandomFloat(0, 360);
+    float angle2 = angle1 + 180;
+    float speed = RandomFloat(tuning->asteroidSpeedMin * 1.5f, tuning->asteroidSpeedMax * 1.5f);
     
-    child1->velocity = (Vector2){cos(angle1) * speed, sin(angle1) * speed};
-    child2->velocity = (Vector2){cos(angle2) * speed, sin(angle2) * speed};
+    child1->velocity = HeadingVector(angle1, speed);
+    child2->velocity = HeadingVector(angle2, speed);
 }
 
 void DestroyAsteroid(Asteroid* asteroid) {
     asteroid->isActive = false;
-    if (asteroid->shape) {
-        free(asteroid->shape);
-        asteroid->shape = nullptr;
-    }
 }
 
 void InitBullet(Bullet* bullet, Vector2 position, float angle, bool fromPlayer) {
     bullet->position = position;
-    bullet->lifetime = BULLET_LIFETIME;
+    bullet->lifetime = tuning->bulletLifetime;
     bullet->isActive = true;
     bullet->fromPlayer = fromPlayer;
     
-    float radians = (angle - 90) * DEG2RAD;
-    bullet->velocity = (Vector2){
-        cos(radians) * BULLET_SPEED,
-        sin(radians) * BULLET_SPEED
-    };
-}
-
-void UpdateBullet(Bullet* bullet, float deltaTime, float screenWidth, float screenHeight) {
-    if (!bullet->isActive) return;
-    
-    bullet->position.x += bullet->velocity.x * deltaTime;
-    bullet->position.y += bullet->velocity.y * deltaTime;
-    
-    bullet->lifetime -= deltaTime;
-    if (bullet->lifetime <= 0) {
-        bullet->isActive = false;
-    }
-    
-    WrapPosition(&bullet->position, screenWidth, screenHeight);
+    bullet->velocity = HeadingVector(angle - 90, tuning->bulletSpeed);
 }
 
 void DrawBullet(const Bullet* bullet) {
@@ -259,112 +399,87 @@ void DestroyBullet(Bullet* bullet) {
     bullet->isActive = false;
 }
 
-void InitUFO(UFO* ufo, UFOType type, float screenWidth, float screenHeight) {
+// UFOs cross `area` from one side to the other: the whole playfield, or the view in open-space worlds
+void InitUFO(UFO* ufo, UFOType type, Rectangle area) {
     ufo->type = type;
     ufo->isActive = true;
-    ufo->shootTimer = 0;
-    ufo->moveTimer = 0;
     
     if (RandomInt(0, 1) == 0) {
-        ufo->position.x = 0;
+        ufo->position.x = area.x;
         ufo->direction = 1;
     } else {
-        ufo->position.x = screenWidth;
+        ufo->position.x = area.x + area.width;
         ufo->direction = -1;
     }
     
-    ufo->position.y = RandomFloat(screenHeight * 0.2f, screenHeight * 0.8f);
+    ufo->position.y = area.y + RandomFloat(area.height * 0.2f, area.height * 0.8f);
     
-    float speed = (type == UFO_LARGE) ? UFO_LARGE_SPEED : UFO_SMALL_SPEED;
+    float speed = (type == UFO_LARGE) ? tuning->ufoLargeSpeed : tuning->ufoSmallSpeed;
     ufo->velocity = (Vector2){speed * ufo->direction, 0};
 }
 
-void UpdateUFO(UFO* ufo, float deltaTime, const Spaceship* target, Bullet* bullets, int maxBullets, float screenWidth) {
+void UpdateUFO(UFO* ufo, float deltaTime, Rectangle area) {
     if (!ufo->isActive) return;
     
-    ufo->position.x += ufo->velocity.x * deltaTime;
-    
+    ufo->position.x = Integrate(ufo->position.x, ufo->velocity.x, deltaTime);
     if (ufo->type == UFO_SMALL) {
-        ufo->moveTimer += deltaTime;
-        if (ufo->moveTimer > 0.5f) {
-            ufo->velocity.y = RandomFloat(-50, 50);
-            ufo->moveTimer = 0;
-        }
-        ufo->position.y += ufo->velocity.y * deltaTime;
+        ufo->position.y = Integrate(ufo->position.y, ufo->velocity.y, deltaTime);
     }
     
-    if ((ufo->direction > 0 && ufo->position.x > screenWidth + UFO_SIZE) ||
-        (ufo->direction < 0 && ufo->position.x < -UFO_SIZE)) {
+    if ((ufo->direction > 0 && ufo->position.x > area.x + area.width + UFO_SIZE) ||
+        (ufo->direction < 0 && ufo->position.x < area.x - UFO_SIZE)) {
         ufo->isActive = false;
     }
-    
-    ufo->shootTimer += deltaTime;
-    if (ufo->shootTimer > UFO_SHOOT_INTERVAL) {
-        ufo->shootTimer = 0;
-        
-        for (int i = 0; i < maxBullets; i++) {
-            if (!bullets[i].isActive) {
-                float angle;
-                if (ufo->type == UFO_SMALL && target && target->isAlive) {
-                    Vector2 toPlayer = Vector2Subtract(target->position, ufo->position);
-                    angle = atan2f(toPlayer.y, toPlayer.x) * RAD2DEG + 90;
-                } else {
-                    angle = RandomFloat(0, 360);
-                }
-                
-                InitBullet(&bullets[i], ufo->position, angle, false);
-                break;
-            }
+}
+
+// Small UFOs weave; the game calls this every UFO_STEER_INTERVAL
+void SteerUFO(UFO* ufo) {
+    ufo->velocity.y = RandomFloat(-50, 50);
+}
+
+// The aim comes from the UFO's gunner pilot (ai.c)
+void FireUFOBullet(const UFO* ufo, float angle, Bullet* bullets, int maxBullets) {
+    for (int i = 0; i < maxBullets; i++) {
+        if (!bullets[i].isActive) {
+            InitBullet(&bullets[i], ufo->position, angle, false);
+            break;
         }
     }
 }
 
+void GetUFOSegments(const UFO* ufo, Vector2 segments[UFO_SEGMENT_COUNT * 2]) {
+    float size = UFO_SIZE * GetUFOScale(ufo->type);
+    float x = ufo->position.x;
+    float y = ufo->position.y;
+    
+    Vector2 left = {x - size, y};
+    Vector2 right = {x + size, y};
+    Vector2 topLeft = {x - size * 0.5f, y - size * 0.3f};
+    Vector2 topRight = {x + size * 0.5f, y - size * 0.3f};
+    Vector2 bottomLeft = {x - size * 0.5f, y + size * 0.3f};
+    Vector2 bottomRight = {x + size * 0.5f, y + size * 0.3f};
+    
+    const Vector2 pairs[UFO_SEGMENT_COUNT * 2] = {
+        left, right,
+        topLeft, topRight,
+        topLeft, left,
+        topRight, right,
+        bottomLeft, bottomRight,
+        bottomLeft, left,
+        bottomRight, right
+    };
+    memcpy(segments, pairs, sizeof(pairs));
+}
+
 void DrawUFO(const UFO* ufo) {
     if (!ufo->isActive) return;
     
-    float size = (ufo->type == UFO_LARGE) ? UFO_SIZE : UFO_SIZE * 0.6f;
-    
-    DrawLineV(
-        (Vector2){ufo->position.x - size, ufo->position.y},
-        (Vector2){ufo->position.x + size, ufo->position.y},
-        WHITE
-    );
-    
-    DrawLineV(
-        (Vector2){ufo->position.x - size * 0.5f, ufo->position.y - size * 0.3f},
-        (Vector2){ufo->position.x + size * 0.5f, ufo->position.y - size * 0.3f},
-        WHITE
-    );
-    
-    DrawLineV(
-        (Vector2){ufo->position.x - size * 0.5f, ufo->position.y - size * 0.3f},
-        (Vector2){ufo->position.x - size, ufo->position.y},
-        WHITE
-    );
-    
-    DrawLineV(
-        (Vector2){ufo->position.x + size * 0.5f, ufo->position.y - size * 0.3f},
-        (Vector2){ufo->position.x + size, ufo->position.y},
-        WHITE
-    );
-    
-    DrawLineV(
-        (Vector2){ufo->position.x - size * 0.5f, ufo->position.y + size * 0.3f},
-        (Vector2){ufo->position.x + size * 0.5f, ufo->position.y + size * 0.3f},
-        WHITE
-    );
-    
-    DrawLineV(
-        (Vector2){ufo->position.x - size * 0.5f, ufo->position.y + size * 0.3f},
-        (Vector2){ufo->position.x - size, ufo->position.y},
-        WHITE
-    );
-    
-    DrawLineV(
-        (Vector2){ufo->position.x + size * 0.5f, ufo->position.y + size * 0.3f},
-        (Vector2){ufo->position.x + size, ufo->position.y},
-        WHITE
-    );
+    Vector2 segments[UFO_SEGMENT_COUNT * 2];
+    GetUFOSegments(ufo, segments);
+    
+    for (int i = 0; i < UFO_SEGMENT_COUNT; i++) {
+        DrawLineV(segments[i * 2], segments[i * 2 + 1], WHITE);
+    }
 }
 
 void DestroyUFO(UFO* ufo) {
@@ -376,4 +491,14 @@ void WrapPosition(Vector2* position, float screenWidth, float screenHeight) {
     if (position->x > screenWidth) position->x = 0;
     if (position->y < 0) position->y = screenHeight;
     if (position->y > screenHeight) position->y = 0;
+}
+
+// Shortest vector from one point to another on the wrapping playfield
+Vector2 GetWrappedOffset(Vector2 from, Vector2 to, float screenWidth, float screenHeight) {
+    Vector2 d = {to.x - from.x, to.y - from.y};
+    if (d.x > screenWidth / 2) d.x -= screenWidth;
+    if (d.x < -screenWidth / 2) d.x += screenWidth;
+    if (d.y > screenHeight / 2) d.y -= screenHeight;
+    if (d.y < -screenHeight / 2) d.y += screenHeight;
+    return d;
 }
\ No newline at end of file
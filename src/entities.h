@@ -23,7 +23,7 @@ typedef struct {
     float rotationSpeed;
     bool isThrusting;
     bool isAlive;
-    float invulnerableTime;
+    bool isInvulnerable;
     int lives;
 } Spaceship;
 
@@ -35,8 +35,7 @@ typedef struct {
     AsteroidSize size;
     bool isActive;
     float radius;
-    Vector2* shape;
-    int shapePointCount;
+    int shapeIndex;
 } Asteroid;
 
 typedef struct {
@@ -52,17 +51,18 @@ typedef struct {
     Vector2 velocity;
     UFOType type;
     bool isActive;
-    float shootTimer;
-    float moveTimer;
     int direction;
 } UFO;
 
 #define MAX_ASTEROIDS 28
+#define MAX_SWARM_ASTEROIDS 4096
 #define MAX_BULLETS 32
 #define MAX_UFOS 2
 #define MAX_ASTEROID_VERTICES 12
+#define ASTEROID_SHAPE_TEMPLATES 16
 
 #define SPACESHIP_SIZE 10.0f
+#define SPACESHIP_BOUND_RADIUS (SPACESHIP_SIZE * 1.25f)
 #define SPACESHIP_THRUST_POWER 250.0f
 #define SPACESHIP_ROTATION_SPEED 250.0f
 #define SPACESHIP_MAX_SPEED 400.0f
@@ -76,39 +76,97 @@ typedef struct {
 #define ASTEROID_LARGE_RADIUS 40.0f
 #define ASTEROID_MEDIUM_RADIUS 25.0f
 #define ASTEROID_SMALL_RADIUS 15.0f
+#define ASTEROID_SHAPE_MIN_SCALE 0.8f
+#define ASTEROID_SHAPE_MAX_SCALE 1.2f
 #define ASTEROID_SPEED_MIN 20.0f
 #define ASTEROID_SPEED_MAX 100.0f
 
 #define UFO_LARGE_SPEED 100.0f
 #define UFO_SMALL_SPEED 150.0f
 #define UFO_SHOOT_INTERVAL 1.5f
+#define UFO_STEER_INTERVAL 0.5f
 #define UFO_SIZE 20.0f
+#define UFO_SEGMENT_COUNT 7
+
+// Per-kind constants live in X-macro tables so lookups and kernels are
+// generated from one place and the compiler can fold them.
+// X(size, radius, points, explosion particles)
+#define ASTEROID_SIZE_TABLE(X) \
+    X(ASTEROID_LARGE, ASTEROID_LARGE_RADIUS, 20, 48) \
+    X(ASTEROID_MEDIUM, ASTEROID_MEDIUM_RADIUS, 50, 32) \
+    X(ASTEROID_SMALL, ASTEROID_SMALL_RADIUS, 100, 20)
+
+// X(type, outline scale, points); both types collide at UFO_SIZE
+#define UFO_TYPE_TABLE(X) \
+    X(UFO_LARGE, 1.0f, 200) \
+    X(UFO_SMALL, 0.6f, 1000)
+
+#define ASTEROID_SIZE_COUNT 3
+
+static inline float GetAsteroidRadius(AsteroidSize size) {
+    static const float radii[ASTEROID_SIZE_COUNT] = {
+#define X(size, radius, points, particles) [size] = radius,
+        ASTEROID_SIZE_TABLE(X)
+#undef X
+    };
+    return radii[size];
+}
+
+static inline float GetUFOScale(UFOType type) {
+    static const float scales[] = {
+#define X(type, scale, points) [type] = scale,
+        UFO_TYPE_TABLE(X)
+#undef X
+    };
+    return scales[type];
+}
+
+// Unit-radius asteroid outline shared by every asteroid using it
+typedef struct {
+    Vector2 points[MAX_ASTEROID_VERTICES];
+    int pointCount;
+} AsteroidShape;
 
 void InitSpaceship(Spaceship* ship, float x, float y);
 void RespawnSpaceship(Spaceship* ship, float x, float y);
 void UpdateSpaceship(Spaceship* ship, float deltaTime);
-void DrawSpaceship(const Spaceship* ship);
+// Invulnerability is timed by the game; the time left only sets the blink
+void DrawSpaceship(const Spaceship* ship, float invulnerableTime);
+bool IsSpaceshipVisible(const Spaceship* ship, float invulnerableTime);
+void GetSpaceshipOutline(const Spaceship* ship, Vector2 hull[3], Vector2 flame[3]);
 void ThrustSpaceship(Spaceship* ship);
 void RotateSpaceship(Spaceship* ship, float direction);
 void HyperspaceJump(Spaceship* ship, float screenWidth, float screenHeight);
 bool IsSpaceshipInvulnerable(const Spaceship* ship);
 
+const AsteroidShape* GetAsteroidShape(int index);
+
 void InitAsteroid(Asteroid* asteroid, float x, float y, AsteroidSize size);
-void UpdateAsteroid(Asteroid* asteroid, float deltaTime, float screenWidth, float screenHeight);
+void UpdateAsteroids(Asteroid* asteroids, int count, float deltaTime, float screenWidth, float screenHeight);
+int FindAsteroidOverlap(const Asteroid* asteroids, int first, int count, Vector2 center, float radius);
 void DrawAsteroid(const Asteroid* asteroid);
+int GetAsteroidOutline(const Asteroid* asteroid, Vector2* points);
 void SplitAsteroid(const Asteroid* parent, Asteroid* child1, Asteroid* child2);
 void DestroyAsteroid(Asteroid* asteroid);
 
 void InitBullet(Bullet* bullet, Vector2 position, float angle, bool fromPlayer);
-void UpdateBullet(Bullet* bullet, float deltaTime, float screenWidth, float screenHeight);
+void UpdateBullets(Bullet* bullets, int count, float deltaTime, float screenWidth, float screenHeight);
 void DrawBullet(const Bullet* bullet);
 void DestroyBullet(Bullet* bullet);
 
-void InitUFO(UFO* ufo, UFOType type, float screenWidth, float screenHeight);
-void UpdateUFO(UFO* ufo, float deltaTime, const Spaceship* target, Bullet* bullets, int maxBullets, float screenWidth);
+void InitUFO(UFO* ufo, UFOType type, Rectangle area);
+void UpdateUFO(UFO* ufo, float deltaTime, Rectangle area);
+void SteerUFO(UFO* ufo);
+void FireUFOBullet(const UFO* ufo, float angle, Bullet* bullets, int maxBullets);
 void DrawUFO(const UFO* ufo);
+void GetUFOSegments(const UFO* ufo, Vector2 segments[UFO_SEGMENT_COUNT * 2]);
 void DestroyUFO(UFO* ufo);
 
 void WrapPosition(Vector2* position, float screenWidth, float screenHeight);
+Vector2 GetWrappedOffset(Vector2 from, Vector2 to, float screenWidth, float screenHeight);
+float GetHeadingDegrees(Vector2 direction);
+float Integrate(float value, float rate, float deltaTime);
+float IntegrateDegrees(float degrees, float rate, float deltaTime);
+bool CheckCirclesOverlap(Vector2 a, float radiusA, Vector2 b, float radiusB);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "env.h"
+#include "game.h"
+#include "utils.h"
+#include "softraster.h"
+#include "jobs.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENV_TICK_DT (1.0f / ENV_TICK_RATE)
+#define ENV_DEFAULT_MAX_STEPS 27000
+
+#define SHIP_FEATURES 10
+#define ENTITY_FEATURES 6
+#define ENTITY_FEATURE_COUNT ((MAX_ASTEROIDS + MAX_BULLETS + MAX_UFOS) * ENTITY_FEATURES)
+#define ENVS_PER_JOB 8
+
+struct AsteroidsEnv {
+    GameState* state;
+    EnvConfig config;
+    uint64_t rngState;
+    uint64_t seed;
+    int steps;
+    SoftFramebuffer frame;
+};
+
+struct AsteroidsVecEnv {
+    int count;
+    int observationSize;
+    AsteroidsEnv** envs;
+    JobPool* jobs;
+    const unsigned int* actions;
+    float* rewards;
+    bool* dones;
+    float* observations;
+};
+
+EnvConfig GetDefaultEnvConfig(void) {
+    return (EnvConfig){
+        .frameSkip = 1,
+        .maxSteps = ENV_DEFAULT_MAX_STEPS,
+        .frameWidth = 0,
+        .frameHeight = 0
+    };
+}
+
+int GetEnvObservationSize(const EnvConfig* config) {
+    return SHIP_FEATURES + ENTITY_FEATURE_COUNT + config->frameWidth * config->frameHeight;
+}
+
+// Shortest offset on the wrapping playfield, normalised to [-1, 1]
+static float WrappedDelta(float from, float to, float extent) {
+    float d = to - from;
+    if (d > extent / 2) d -= extent;
+    if (d < -extent / 2) d += extent;
+    return d / (extent / 2);
+}
+
+static float* WriteEntity(float* out, const Spaceship* ship, bool active, Vector2 position,
+                          Vector2 velocity, float extra, float width, float height) {
+    if (!active) {
+        memset(out, 0, ENTITY_FEATURES * sizeof(float));
+        return out + ENTITY_FEATURES;
+    }
+    
+    out[0] = 1.0f;
+    out[1] = WrappedDelta(ship->position.x, position.x, width);
+    out[2] = WrappedDelta(ship->position.y, position.y, height);
+    out[3] = velocity.x / SPACESHIP_MAX_SPEED;
+    out[4] = velocity.y / SPACESHIP_MAX_SPEED;
+    out[5] = extra;
+    return out + ENTITY_FEATURES;
+}
+
+static void WriteFrame(AsteroidsEnv* env, float* out) {
+    RasterizeGameState(env->state, &env->frame);
+    
+    const SoftFramebuffer* frame = &env->frame;
+    for (int y = 0; y < frame->height; y++) {
+        const unsigned char* row = frame->pixels + y * frame->stride;
+        for (int x = 0; x < frame->width; x++) {
+            *out++ = row[x] * (1.0f / 255.0f);
+        }
+    }
+}
+
+static void WriteObservation(AsteroidsEnv* env, float* out) {
+    if (!out) return;
+    
+    const GameState* state = env->state;
+    const Spaceship* ship = &state->ship;
+    float w = state->screenWidth;
+    float h = state->screenHeight;
+    float radians = ship->rotation * DEG2RAD;
+    
+    out[0] = ship->position.x / w;
+    out[1] = ship->position.y / h;
+    out[2] = ship->velocity.x / SPACESHIP_MAX_SPEED;
+    out[3] = ship->velocity.y / SPACESHIP_MAX_SPEED;
+    out[4] = sinf(radians);
+    out[5] = cosf(radians);
+    out[6] = ship->isAlive ? 1.0f : 0.0f;
+    out[7] = IsSpaceshipInvulnerable(ship) ? 1.0f : 0.0f;
+    out[8] = ship->lives / 3.0f;
+    out[9] = CanFireBullet(state) ? 0.0f : 1.0f;
+    out += SHIP_FEATURES;
+    
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        const Asteroid* a = &state->asteroids[i];
+        out = WriteEntity(out, ship, a->isActive, a->position, a->velocity, a->radius / ASTEROID_LARGE_RADIUS, w, h);
+    }
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        const Bullet* b = &state->bullets[i];
+        out = WriteEntity(out, ship, b->isActive, b->position, b->velocity, b->fromPlayer ? 1.0f : -1.0f, w, h);
+    }
+    for (int i = 0; i < MAX_UFOS; i++) {
+        const UFO* u = &state->ufos[i];
+        out = WriteEntity(out, ship, u->isActive, u->position, u->velocity, u->type == UFO_SMALL ? 1.0f : 0.0f, w, h);
+    }
+    
+    if (env->frame.pixels) {
+        WriteFrame(env, out);
+    }
+}
+
+// An environment is one session arena: the game state, then the environment
+// itself and its frame, all sized here and released together
+AsteroidsEnv* CreateEnv(const EnvConfig* config) {
+    EnvConfig settings = config ? *config : GetDefaultEnvConfig();
+    if (settings.frameSkip < 1) settings.frameSkip = 1;
+    if (settings.frameWidth <= 0 || settings.frameHeight <= 0) {
+        settings.frameWidth = 0;
+        settings.frameHeight = 0;
+    }
+    
+    size_t frameBytes = GetSoftFramebufferBytes(settings.frameWidth, settings.frameHeight);
+    size_t sessionBytes = GetArenaAllocSize(sizeof(AsteroidsEnv), ARENA_DEFAULT_ALIGNMENT) +
+                          GetArenaAllocSize(frameBytes, SOFT_FRAMEBUFFER_ALIGNMENT);
+    
+    GameState* state = CreateWorldGameState(ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT,
+                                            ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT, MAX_ASTEROIDS, sessionBytes);
+    if (!state) return nullptr;
+    
+    AsteroidsEnv* env = AllocateSessionMemory(state, sizeof(AsteroidsEnv), ARENA_DEFAULT_ALIGNMENT, MEMORY_TAG_ENV);
+    env->state = state;
+    env->config = settings;
+    
+    if (frameBytes > 0) {
+        unsigned char* pixels = AllocateSessionMemory(state, frameBytes, SOFT_FRAMEBUFFER_ALIGNMENT, MEMORY_TAG_FRAMEBUFFER);
+        env->frame = InitSoftFramebuffer(settings.frameWidth, settings.frameHeight, pixels);
+    }
+    
+    return env;
+}
+
+void DestroyEnv(AsteroidsEnv* env) {
+    if (!env) return;
+    DestroyGameState(env->state);
+}
+
+// Environments are headless and may run on pool workers, so particles and sounds stay
+// off while they tick; the caller's effects switch is restored afterwards
+void ResetEnv(AsteroidsEnv* env, uint64_t seed, float* observation) {
+    bool savedEffects = AreEffectsEnabled();
+    SetEffectsEnabled(false);
+    SeedRandom(seed);
+    
+    env->seed = seed;
+    env->steps = 0;
+    env->state->highScore = 0;
+    InitGame(env->state);
+    StartNewGame(env->state);
+    env->rngState = GetRandomState();
+    
+    SetEffectsEnabled(savedEffects);
+    WriteObservation(env, observation);
+}
+
+// Advances frameSkip ticks with the same controls; hyperspace only fires on the first
+float StepEnv(AsteroidsEnv* env, unsigned int actions, bool* done, float* observation) {
+    GameState* state = env->state;
+    int scoreBefore = state->score;
+    
+    bool savedEffects = AreEffectsEnabled();
+    SetEffectsEnabled(false);
+    SetRandomState(env->rngState);
+    
+    for (int i = 0; i < env->config.frameSkip && state->state == GAME_STATE_PLAYING; i++) {
+        ApplyShipActions(state, (i == 0) ? actions : (actions & ~ACTION_HYPERSPACE));
+        UpdateGame(state, ENV_TICK_DT);
+    }
+    
+    env->rngState = GetRandomState();
+    env->steps++;
+    SetEffectsEnabled(savedEffects);
+    
+    if (done) {
+        *done = state->state != GAME_STATE_PLAYING ||
+                (env->config.maxSteps > 0 && env->steps >= env->config.maxSteps);
+    }
+    
+    WriteObservation(env, observation);
+    return (float)(state->score - scoreBefore);
+}
+
+AsteroidsVecEnv* CreateVecEnv(int count, const EnvConfig* config, int workerCount) {
+    AsteroidsVecEnv* vec = calloc(1, sizeof(AsteroidsVecEnv));
+    if (!vec) return nullptr;
+    
+    vec->envs = calloc(count, sizeof(AsteroidsEnv*));
+    if (!vec->envs) {
+        free(vec);
+        return nullptr;
+    }
+    
+    vec->count = count;
+    for (int i = 0; i < count; i++) {
+        vec->envs[i] = CreateEnv(config);
+        if (!vec->envs[i]) {
+            DestroyVecEnv(vec);
+            return nullptr;
+        }
+    }
+    vec->observationSize = GetEnvObservationSize(&vec->envs[0]->config);
+    
+    if (workerCount > 0) {
+        vec->jobs = CreateJobPool(workerCount);
+    }
+    
+    return vec;
+}
+
+void DestroyVecEnv(AsteroidsVecEnv* vec) {
+    if (!vec) return;
+    
+    DestroyJobPool(vec->jobs);
+    for (int i = 0; i < vec->count; i++) {
+        DestroyEnv(vec->envs[i]);
+    }
+    free(vec->envs);
+    free(vec);
+}
+
+// Environment i starts from seed + i; observations are laid out contiguously, one row per env
+void ResetVecEnv(AsteroidsVecEnv* vec, uint64_t seed, float* observations) {
+    for (int i = 0; i < vec->count; i++) {
+        float* row = observations ? observations + (size_t)i * vec->observationSize : nullptr;
+        ResetEnv(vec->envs[i], seed + i, row);
+    }
+}
+
+static void StepVecEnvJob(void* context, int job) {
+    AsteroidsVecEnv* vec = context;
+    int first = job * ENVS_PER_JOB;
+    int last = first + ENVS_PER_JOB;
+    if (last > vec->count) last = vec->count;
+    
+    for (int i = first; i < last; i++) {
+        AsteroidsEnv* env = vec->envs[i];
+        float* row = vec->observations ? vec->observations + (size_t)i * vec->observationSize : nullptr;
+        bool done = false;
+        
+        float reward = StepEnv(env, vec->actions[i], &done, row);
+        if (done) {
+            ResetEnv(env, env->seed + vec->count, row);
+        }
+        
+        if (vec->rewards) vec->rewards[i] = reward;
+        if (vec->dones) vec->dones[i] = done;
+    }
+}
+
+// Finished environments reset in place with seed + count, so the returned
+// observation for a done env is already the first one of its next episode.
+// Each env owns its random stream, so results do not depend on the worker count.
+void StepVecEnv(AsteroidsVecEnv* vec, const unsigned int* actions, float* rewards, bool* dones, float* observations) {
+    vec->actions = actions;
+    vec->rewards = rewards;
+    vec->dones = dones;
+    vec->observations = observations;
+    
+    RunJobs(vec->jobs, StepVecEnvJob, vec, (vec->count + ENVS_PER_JOB - 1) / ENVS_PER_JOB);
+}
@@ -0,0 +1,37 @@
+#ifndef ENV_H
+#define ENV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Headless training environment over the game.c rules. Actions are ShipAction
+// bitmasks and observations are written straight into caller-owned buffers.
+
+#define ENV_PLAYFIELD_WIDTH 1920.0f
+#define ENV_PLAYFIELD_HEIGHT 1080.0f
+#define ENV_TICK_RATE 60
+
+typedef struct {
+    int frameSkip;
+    int maxSteps;
+    int frameWidth;
+    int frameHeight;
+} EnvConfig;
+
+typedef struct AsteroidsEnv AsteroidsEnv;
+typedef struct AsteroidsVecEnv AsteroidsVecEnv;
+
+EnvConfig GetDefaultEnvConfig(void);
+int GetEnvObservationSize(const EnvConfig* config);
+
+AsteroidsEnv* CreateEnv(const EnvConfig* config);
+void DestroyEnv(AsteroidsEnv* env);
+void ResetEnv(AsteroidsEnv* env, uint64_t seed, float* observation);
+float StepEnv(AsteroidsEnv* env, unsigned int actions, bool* done, float* observation);
+
+AsteroidsVecEnv* CreateVecEnv(int count, const EnvConfig* config, int workerCount);
+void DestroyVecEnv(AsteroidsVecEnv* vec);
+void ResetVecEnv(AsteroidsVecEnv* vec, uint64_t seed, float* observations);
+void StepVecEnv(AsteroidsVecEnv* vec, const unsigned int* actions, float* rewards, bool* dones, float* observations);
+
+#endif
\ No newline at end of file
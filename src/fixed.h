@@ -0,0 +1,50 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+// Q16.16 fixed-point: 16 integer bits and 16 fraction bits in an int32_t.
+// Everything here is integer arithmetic, trig included, so results are
+// bit-identical on every target. Products that can leave the Q16.16 range,
+// such as squared distances, are kept in 64 bits.
+
+typedef int32_t Fixed;
+
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+
+// Scaling by a power of two is exact, so conversion only truncates the
+// fraction below 1/65536, which every IEEE-754 target does the same way.
+// Out-of-range values saturate and NaN gives 0: a raw conversion would be
+// undefined there, giving INT_MIN on x86 and trapping on wasm.
+static inline Fixed FixedFromFloat(float value) {
+    float scaled = value * (float)FIXED_ONE;
+    if (scaled >= 2147483648.0f) return INT32_MAX;
+    if (scaled < -2147483648.0f) return INT32_MIN;
+    if (scaled != scaled) return 0;
+    return (Fixed)scaled;
+}
+
+static inline float FixedToFloat(Fixed value) {
+    return (float)value / (float)FIXED_ONE;
+}
+
+static inline Fixed FixedMul(Fixed a, Fixed b) {
+    return (Fixed)(((int64_t)a * b) >> FIXED_SHIFT);
+}
+
+static inline Fixed FixedDiv(Fixed a, Fixed b) {
+    return (Fixed)(((int64_t)a * FIXED_ONE) / b);
+}
+
+// Exact squared length in Q32.32
+static inline int64_t FixedLengthSquared(Fixed x, Fixed y) {
+    return (int64_t)x * x + (int64_t)y * y;
+}
+
+Fixed FixedSqrtWide(int64_t valueQ32);
+Fixed FixedSinDegrees(Fixed degrees);
+Fixed FixedCosDegrees(Fixed degrees);
+Fixed FixedAtan2Degrees(Fixed y, Fixed x);
+
+#endif
@@ -1,41 +1,105 @@
 #include "game.h"
+#include "ai.h"
 #include "utils.h"
+#include "tuning.h"
 #include "audio.h"
+#include "hud.h"
+#include "instancing.h"
+#include "particles.h"
+#include "telemetry.h"
+#include "world.h"
 #include "raymath.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
 
-#define INITIAL_ASTEROIDS 4
-#define ASTEROIDS_PER_LEVEL 2
-#define MAX_LEVEL_ASTEROIDS 12
-#define UFO_BASE_SPAWN_TIME 20.0f
-#define UFO_MIN_SPAWN_TIME 10.0f
-#define FIRE_DELAY 0.25f
-#define NEXT_LEVEL_DELAY 2.0f
+#define UFO_EXPLOSION_PARTICLES 40
+#define SHIP_EXPLOSION_PARTICLES 60
+
+// Per thread, like the random stream, so profiled runs can share a process
+static thread_local GamePhaseTimes* phaseProfile = nullptr;
+
+// One gunner per UFO slot. They keep only accounting between shots, so every
+// state stepped on a thread, copies included, can share that thread's gunners.
+static thread_local AIPilot ufoGunners[MAX_UFOS];
 
 GameState* CreateGameState(float screenWidth, float screenHeight) {
-    GameState* state = calloc(1, sizeof(GameState));
-    if (!state) return nullptr;
+    return CreateGameStateEx(screenWidth, screenHeight, MAX_ASTEROIDS);
+}
+
+GameState* CreateGameStateEx(float screenWidth, float screenHeight, int maxAsteroids) {
+    return CreateWorldGameState(screenWidth, screenHeight, screenWidth, screenHeight, maxAsteroids, 0);
+}
+
+// A world larger than the screen becomes an open-space world with chunk lists.
+// The state is the first allocation in its session arena, which also holds
+// sessionBytes for AllocateSessionMemory().
+GameState* CreateWorldGameState(float screenWidth, float screenHeight, float worldWidth, float worldHeight,
+                                int maxAsteroids, size_t sessionBytes) {
+    if (maxAsteroids < 1) maxAsteroids = 1;
+    if (maxAsteroids > MAX_SWARM_ASTEROIDS) maxAsteroids = MAX_SWARM_ASTEROIDS;
+    if (worldWidth < screenWidth) worldWidth = screenWidth;
+    if (worldHeight < screenHeight) worldHeight = screenHeight;
+    
+    int columns = 0;
+    int rows = 0;
+    if (worldWidth > screenWidth || worldHeight > screenHeight) {
+        GetWorldChunkGrid(worldWidth, worldHeight, &columns, &rows);
+    }
     
+    size_t stateBytes = GetArenaAllocSize(GetGameStateSize(maxAsteroids, columns * rows), GAME_STATE_ALIGNMENT);
+    Arena* arena = CreateArena(stateBytes + sessionBytes);
+    if (!arena) return nullptr;
+    
+    // Three consecutive pieces of one block, split only so the report can tell them apart
+    GameState* state = ArenaAlloc(arena, sizeof(GameState), GAME_STATE_ALIGNMENT, MEMORY_TAG_STATE);
+    ArenaAlloc(arena, (size_t)maxAsteroids * sizeof(Asteroid), 1, MEMORY_TAG_ASTEROIDS);
+    ArenaAlloc(arena, GetWorldChunkBytes(columns * rows, maxAsteroids), 1, MEMORY_TAG_WORLD);
+    
+    state->arena = arena;
     state->screenWidth = screenWidth;
     state->screenHeight = screenHeight;
+    state->worldWidth = worldWidth;
+    state->worldHeight = worldHeight;
+    state->camera = (Vector2){worldWidth / 2, worldHeight / 2};
+    state->chunkColumns = columns;
+    state->chunkRows = rows;
     state->highScore = 0;
+    state->levelSet = LEVEL_SET_CLASSIC;
+    state->maxAsteroids = maxAsteroids;
     
     return state;
 }
 
+size_t GetGameStateSize(int maxAsteroids, int chunkCount) {
+    return sizeof(GameState) + (size_t)maxAsteroids * sizeof(Asteroid) + GetWorldChunkBytes(chunkCount, maxAsteroids);
+}
+
+// Releases the state and everything allocated from its session in one free
 void DestroyGameState(GameState* state) {
     if (!state) return;
-    
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (state->asteroids[i].shape) {
-            free(state->asteroids[i].shape);
-        }
-    }
-    
-    free(state);
+    DestroyArena(state->arena);
+}
+
+// Zeroed memory that lives as long as the state; the state must have been
+// created with room for it
+void* AllocateSessionMemory(GameState* state, size_t size, size_t alignment, MemoryTag tag) {
+    return ArenaAlloc(state->arena, size, alignment, tag);
+}
+
+void WriteSessionMemoryReport(const GameState* state, FILE* out) {
+    WriteArenaReport(state->arena, "session arena", out);
+}
+
+// Entities hold no pointers (asteroid outlines are shared by index, chunk
+// lists by slot), so a copy is one flat memcpy. The destination keeps its own
+// arena and must have been created with the same asteroid slots and world
+// size as the source.
+void CopyGameState(GameState* dest, const GameState* src) {
+    size_t skip = offsetof(GameState, ship);
+    size_t size = GetGameStateSize(src->maxAsteroids, src->chunkColumns * src->chunkRows);
+    memcpy((unsigned char*)dest + skip, (const unsigned char*)src + skip, size - skip);
 }
 
 void InitGame(GameState* state) {
@@ -44,52 +108,49 @@ void InitGame(GameState* state) {
 }
 
 void StartNewGame(GameState* state) {
+    state->seed = GetRandomState();
+    state->playTime = 0;
     state->score = 0;
     state->level = 1;
     state->asteroidCount = 0;
-    state->ufoSpawnTimer = 0;
-    state->nextUFOSpawn = UFO_BASE_SPAWN_TIME;
-    state->fireDelay = 0;
-    state->nextLevelDelay = 0;
-    state->respawnDelay = 0;
+    state->tick = 0;
+    state->camera = (Vector2){state->worldWidth / 2, state->worldHeight / 2};
+    InitTimerWheel(&state->timers);
     
-    InitSpaceship(&state->ship, state->screenWidth / 2, state->screenHeight / 2);
+    InitSpaceship(&state->ship, state->camera.x, state->camera.y);
+    ScheduleTimer(&state->timers, TIMER_SHIP_INVULNERABLE, tuning->shipInvulnerableTime);
     
-    memset(state->asteroids, 0, sizeof(state->asteroids));
+    memset(state->asteroids, 0, state->maxAsteroids * sizeof(Asteroid));
     memset(state->bullets, 0, sizeof(state->bullets));
     memset(state->ufos, 0, sizeof(state->ufos));
+    ClearParticles();
     
     StartNewLevel(state);
     state->state = GAME_STATE_PLAYING;
 }
 
 void StartNewLevel(GameState* state) {
-    int asteroidCount = INITIAL_ASTEROIDS + (state->level - 1) * ASTEROIDS_PER_LEVEL;
-    if (asteroidCount > MAX_LEVEL_ASTEROIDS) {
-        asteroidCount = MAX_LEVEL_ASTEROIDS;
-    }
+    const LevelDefinition* definition = GetLevelDefinition(state->levelSet, state->level);
     
-    SpawnAsteroids(state, asteroidCount);
+    SpawnIndex index;
+    BuildSpawnIndex(&index, state->worldWidth, state->worldHeight, GetLevelAsteroidTotal(definition),
+                    state->ship.position, definition->safeRadius);
+    SpawnAsteroids(state, &index, definition->largeAsteroids, ASTEROID_LARGE);
+    SpawnAsteroids(state, &index, definition->smallAsteroids, ASTEROID_SMALL);
+    RebuildWorldChunks(state);
     
-    state->nextUFOSpawn = UFO_BASE_SPAWN_TIME - (state->level * 2);
-    if (state->nextUFOSpawn < UFO_MIN_SPAWN_TIME) {
-        state->nextUFOSpawn = UFO_MIN_SPAWN_TIME;
-    }
-    state->ufoSpawnTimer = 0;
+    state->nextUFOSpawn = tuning->ufoBaseSpawnTime * definition->ufoSpawnScale;
+    ScheduleTimer(&state->timers, TIMER_UFO_SPAWN, state->nextUFOSpawn);
 }
 
-void SpawnAsteroids(GameState* state, int count) {
+// Fills free slots in one pass; asteroids beyond the state's capacity are dropped
+void SpawnAsteroids(GameState* state, SpawnIndex* index, int count, AsteroidSize size) {
     int spawned = 0;
     
-    for (int i = 0; i < MAX_ASTEROIDS && spawned < count; i++) {
+    for (int i = 0; i < state->maxAsteroids && spawned < count; i++) {
         if (!state->asteroids[i].isActive) {
-            float x, y;
-            do {
-                x = RandomFloat(0, state->screenWidth);
-                y = RandomFloat(0, state->screenHeight);
-            } while (Vector2Distance((Vector2){x, y}, state->ship.position) < 100);
-            
-            InitAsteroid(&state->asteroids[i], x, y, ASTEROID_LARGE);
+            Vector2 position = NextSpawnPosition(index);
+            InitAsteroid(&state->asteroids[i], position.x, position.y, size);
             spawned++;
             state->asteroidCount++;
         }
@@ -101,74 +162,149 @@ void SpawnUFO(GameState* state) {
         if (!state->ufos[i].isActive) {
             UFOType type = (state->score < 10000) ? UFO_LARGE : 
                           (RandomInt(0, 2) == 0 ? UFO_LARGE : UFO_SMALL);
-            InitUFO(&state->ufos[i], type, state->screenWidth, state->screenHeight);
+            InitUFO(&state->ufos[i], type, GetWorldView(state));
+            ScheduleTimer(&state->timers, TIMER_UFO_SHOOT + i, tuning->ufoShootInterval);
+            if (type == UFO_SMALL) {
+                ScheduleTimer(&state->timers, TIMER_UFO_STEER + i, UFO_STEER_INTERVAL);
+            }
+            EmitTelemetry(TELEMETRY_UFO_SPAWNED, type, state->ufos[i].position.x, state->ufos[i].position.y, 0);
             PlayUFOSound();
             break;
         }
     }
 }
 
+// Timers fire at the end of the tick, after collisions, where the old
+// per-tick countdowns were checked
+static void OnGameTimer(void* context, int timer) {
+    GameState* state = context;
+    
+    if (timer >= TIMER_UFO_SHOOT && timer < TIMER_UFO_SHOOT + MAX_UFOS) {
+        // A UFO that left or was destroyed keeps its timers until they next come due, then they lapse
+        UFO* ufo = &state->ufos[timer - TIMER_UFO_SHOOT];
+        if (!ufo->isActive) return;
+        AIPilot* gunner = &ufoGunners[timer - TIMER_UFO_SHOOT];
+        if (!gunner->behaviour) InitAIPilot(gunner, &AI_BEHAVIOUR_UFO_GUNNER, AI_UFO_BUDGET_US);
+        gunner->ufo = timer - TIMER_UFO_SHOOT;
+        if (UpdateAIPilot(gunner, state) & ACTION_FIRE) {
+            FireUFOBullet(ufo, gunner->aim, state->bullets, MAX_BULLETS);
+        }
+        ScheduleTimer(&state->timers, timer, tuning->ufoShootInterval);
+        return;
+    }
+    if (timer >= TIMER_UFO_STEER && timer < TIMER_UFO_STEER + MAX_UFOS) {
+        UFO* ufo = &state->ufos[timer - TIMER_UFO_STEER];
+        if (!ufo->isActive) return;
+        SteerUFO(ufo);
+        ScheduleTimer(&state->timers, timer, UFO_STEER_INTERVAL);
+        return;
+    }
+    
+    switch (timer) {
+        case TIMER_SHIP_INVULNERABLE:
+            state->ship.isInvulnerable = false;
+            break;
+            
+        case TIMER_UFO_SPAWN:
+            SpawnUFO(state);
+            ScheduleTimer(&state->timers, TIMER_UFO_SPAWN, state->nextUFOSpawn);
+            break;
+            
+        case TIMER_NEXT_LEVEL:
+            state->level++;
+            StartNewLevel(state);
+            break;
+            
+        case TIMER_RESPAWN:
+            if (state->ship.lives > 0) {
+                RespawnSpaceship(&state->ship, state->camera.x, state->camera.y);
+                ScheduleTimer(&state->timers, TIMER_SHIP_INVULNERABLE, tuning->shipInvulnerableTime);
+                EmitTelemetry(TELEMETRY_SHIP_RESPAWNED, 0, state->ship.position.x, state->ship.position.y,
+                              state->ship.lives);
+            } else {
+                GameOver(state);
+            }
+            break;
+    }
+}
+
+// Profiling off costs one thread-local load per phase
+void SetGamePhaseProfile(GamePhaseTimes* times) {
+    phaseProfile = times;
+}
+
+const char* GetGamePhaseName(GamePhase phase) {
+    static const char* names[GAME_PHASE_COUNT] = {
+        [GAME_PHASE_SHIP] = "ship",
+        [GAME_PHASE_ASTEROIDS] = "asteroids",
+        [GAME_PHASE_BULLETS] = "bullets",
+        [GAME_PHASE_UFOS] = "ufos",
+        [GAME_PHASE_COLLISIONS] = "collisions",
+        [GAME_PHASE_EFFECTS] = "effects",
+        [GAME_PHASE_TIMERS] = "timers"
+    };
+    return (phase >= 0 && phase < GAME_PHASE_COUNT) ? names[phase] : "unknown";
+}
+
+// Charges the time since the previous mark to a phase
+static inline void MarkGamePhase(GamePhase phase, double* mark) {
+    if (!phaseProfile) return;
+    double now = GetMonotonicTime();
+    phaseProfile->seconds[phase] += now - *mark;
+    *mark = now;
+}
+
 void UpdateGame(GameState* state, float deltaTime) {
+    double mark = phaseProfile ? GetMonotonicTime() : 0;
+    
     switch (state->state) {
         case GAME_STATE_MENU:
             break;
             
         case GAME_STATE_PLAYING:
+            state->playTime += deltaTime;
+            state->tick++;
             UpdateSpaceship(&state->ship, deltaTime);
-            WrapPosition(&state->ship.position, state->screenWidth, state->screenHeight);
-            
-            for (int i = 0; i < MAX_ASTEROIDS; i++) {
-                UpdateAsteroid(&state->asteroids[i], deltaTime, state->screenWidth, state->screenHeight);
-            }
+            WrapPosition(&state->ship.position, state->worldWidth, state->worldHeight);
+            FollowWorldCamera(state);
+            MarkGamePhase(GAME_PHASE_SHIP, &mark);
             
-            for (int i = 0; i < MAX_BULLETS; i++) {
-                UpdateBullet(&state->bullets[i], deltaTime, state->screenWidth, state->screenHeight);
+            if (IsOpenWorld(state)) {
+                StepWorldAsteroids(state, deltaTime);
+            } else {
+                UpdateAsteroids(state->asteroids, state->maxAsteroids, deltaTime, state->worldWidth, state->worldHeight);
             }
+            MarkGamePhase(GAME_PHASE_ASTEROIDS, &mark);
+            UpdateBullets(state->bullets, MAX_BULLETS, deltaTime, state->worldWidth, state->worldHeight);
+            MarkGamePhase(GAME_PHASE_BULLETS, &mark);
             
             for (int i = 0; i < MAX_UFOS; i++) {
-                UpdateUFO(&state->ufos[i], deltaTime, &state->ship, state->bullets, MAX_BULLETS, state->screenWidth);
-            }
-            
-            state->ufoSpawnTimer += deltaTime;
-            if (state->ufoSpawnTimer > state->nextUFOSpawn) {
-                SpawnUFO(state);
-                state->ufoSpawnTimer = 0;
-            }
-            
-            if (state->fireDelay > 0) {
-                state->fireDelay -= deltaTime;
+                // Open-space UFOs cross the view, so keep them on the camera's side of any wrapped edge
+                if (IsOpenWorld(state) && state->ufos[i].isActive) {
+                    Vector2 offset = GetWrappedOffset(state->camera, state->ufos[i].position, state->worldWidth, state->worldHeight);
+                    state->ufos[i].position = Vector2Add(state->camera, offset);
+                }
+                UpdateUFO(&state->ufos[i], deltaTime, GetWorldView(state));
             }
+            MarkGamePhase(GAME_PHASE_UFOS, &mark);
             
             CheckCollisions(state);
+            MarkGamePhase(GAME_PHASE_COLLISIONS, &mark);
+            UpdateParticles(deltaTime);
+            MarkGamePhase(GAME_PHASE_EFFECTS, &mark);
             
-            if (state->asteroidCount == 0) {
-                state->nextLevelDelay += deltaTime;
-                if (state->nextLevelDelay > NEXT_LEVEL_DELAY) {
-                    state->level++;
-                    StartNewLevel(state);
-                    state->nextLevelDelay = 0;
-                }
+            if (state->asteroidCount == 0 && !IsTimerPending(&state->timers, TIMER_NEXT_LEVEL)) {
+                ScheduleTimer(&state->timers, TIMER_NEXT_LEVEL, tuning->nextLevelDelay);
             }
             
-            // Handle ship death and respawn
-            if (!state->ship.isAlive) {
-                if (state->respawnDelay == 0) {
-                    // Just died, decrement lives
-                    state->ship.lives--;
-                    state->respawnDelay = 2.0f; // 2 second delay before respawn
-                } else {
-                    // Waiting to respawn
-                    state->respawnDelay -= deltaTime;
-                    if (state->respawnDelay <= 0) {
-                        state->respawnDelay = 0;
-                        if (state->ship.lives > 0) {
-                            RespawnSpaceship(&state->ship, state->screenWidth / 2, state->screenHeight / 2);
-                        } else {
-                            GameOver(state);
-                        }
-                    }
-                }
+            // A ship that just died loses a life and waits to respawn
+            if (!state->ship.isAlive && !IsTimerPending(&state->timers, TIMER_RESPAWN)) {
+                state->ship.lives--;
+                ScheduleTimer(&state->timers, TIMER_RESPAWN, tuning->respawnDelay);
             }
+            
+            AdvanceTimers(&state->timers, deltaTime, OnGameTimer, state);
+            MarkGamePhase(GAME_PHASE_TIMERS, &mark);
             break;
             
         case GAME_STATE_PAUSED:
@@ -182,74 +318,88 @@ void UpdateGame(GameState* state, float deltaTime) {
 void DrawGame(const GameState* state) {
     switch (state->state) {
         case GAME_STATE_MENU:
-            DrawText("ASTEROIDS", state->screenWidth/2 - 100, state->screenHeight/2 - 50, 30, WHITE);
-            DrawText("Press SPACE to Start", state->screenWidth/2 - 110, state->screenHeight/2, 20, WHITE);
-            DrawText("Press F1 for Help", state->screenWidth/2 - 70, state->screenHeight/2 + 50, 14, WHITE);
+            DrawMenuScreen(state);
             break;
             
         case GAME_STATE_PLAYING:
         case GAME_STATE_PAUSED:
-            DrawSpaceship(&state->ship);
-            
-            for (int i = 0; i < MAX_ASTEROIDS; i++) {
-                DrawAsteroid(&state->asteroids[i]);
-            }
-            
-            for (int i = 0; i < MAX_BULLETS; i++) {
-                DrawBullet(&state->bullets[i]);
-            }
-            
-            for (int i = 0; i < MAX_UFOS; i++) {
-                DrawUFO(&state->ufos[i]);
+            if (IsOpenWorld(state)) {
+                DrawWorld(state);
+            } else {
+                DrawSpaceship(&state->ship, GetShipInvulnerableTime(state));
+                
+                DrawAsteroidsInstanced(state->asteroids, state->maxAsteroids);
+                
+                for (int i = 0; i < MAX_BULLETS; i++) {
+                    DrawBullet(&state->bullets[i]);
+                }
+                
+                for (int i = 0; i < MAX_UFOS; i++) {
+                    DrawUFO(&state->ufos[i]);
+                }
+                
+                DrawParticles();
             }
             
-            char scoreText[32];
-            snprintf(scoreText, sizeof(scoreText), "Score: %d", state->score);
-            DrawText(scoreText, 10, 10, 20, WHITE);
-            
-            snprintf(scoreText, sizeof(scoreText), "High: %d", state->highScore);
-            DrawText(scoreText, 10, 35, 20, WHITE);
-            
-            snprintf(scoreText, sizeof(scoreText), "Level: %d", state->level);
-            DrawText(scoreText, 10, 60, 20, WHITE);
-            
-            for (int i = 0; i < state->ship.lives; i++) {
-                Vector2 p1 = {30.0f + i * 25, 90};
-                Vector2 p2 = {20.0f + i * 25, 105};
-                Vector2 p3 = {40.0f + i * 25, 105};
-                DrawLineV(p1, p2, WHITE);
-                DrawLineV(p2, p3, WHITE);
-                DrawLineV(p3, p1, WHITE);
-            }
+            DrawHud();
             
             if (state->state == GAME_STATE_PAUSED) {
-                DrawText("PAUSED", state->screenWidth/2 - 50, state->screenHeight/2, 30, WHITE);
+                DrawPausedScreen(state);
             }
             break;
             
         case GAME_STATE_GAME_OVER:
-            DrawText("GAME OVER", state->screenWidth/2 - 80, state->screenHeight/2 - 50, 30, WHITE);
-            
-            char finalScore[64];
-            snprintf(finalScore, sizeof(finalScore), "Final Score: %d", state->score);
-            DrawText(finalScore, state->screenWidth/2 - 80, state->screenHeight/2, 20, WHITE);
-            
-            if (state->showingHighScore) {
-                DrawText("NEW HIGH SCORE!", state->screenWidth/2 - 90, state->screenHeight/2 + 30, 20, YELLOW);
-            }
-            
-            DrawText("Press SPACE to Play Again", state->screenWidth/2 - 130, state->screenHeight/2 + 60, 20, WHITE);
+            DrawGameOverScreen(state);
             break;
     }
 }
 
+void ApplyShipActions(GameState* state, unsigned int actions) {
+    state->ship.isThrusting = false;
+    state->ship.rotationSpeed = 0;
+    
+    if (actions & ACTION_THRUST) {
+        ThrustSpaceship(&state->ship);
+    }
+    
+    if (actions & ACTION_ROTATE_LEFT) {
+        RotateSpaceship(&state->ship, -1);
+    }
+    
+    if (actions & ACTION_ROTATE_RIGHT) {
+        RotateSpaceship(&state->ship, 1);
+    }
+    
+    if (actions & ACTION_FIRE) {
+        FireBullet(state);
+    }
+    
+    // Jumps land somewhere on screen, which in an open-space world is the view
+    if (actions & ACTION_HYPERSPACE) {
+        Rectangle view = GetWorldView(state);
+        HyperspaceJump(&state->ship, view.width, view.height);
+        state->ship.position.x += view.x;
+        state->ship.position.y += view.y;
+        WrapPosition(&state->ship.position, state->worldWidth, state->worldHeight);
+    }
+}
+
+bool CanFireBullet(const GameState* state) {
+    return !IsTimerPending(&state->timers, TIMER_FIRE);
+}
+
+float GetShipInvulnerableTime(const GameState* state) {
+    return GetTimerRemaining(&state->timers, TIMER_SHIP_INVULNERABLE);
+}
+
 void FireBullet(GameState* state) {
-    if (state->fireDelay > 0 || !state->ship.isAlive) return;
+    if (!CanFireBullet(state) || !state->ship.isAlive) return;
     
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (!state->bullets[i].isActive) {
             InitBullet(&state->bullets[i], state->ship.position, state->ship.rotation, true);
-            state->fireDelay = FIRE_DELAY;
+            ScheduleTimer(&state->timers, TIMER_FIRE, tuning->fireDelay);
+            EmitTelemetry(TELEMETRY_BULLET_FIRED, 0, state->ship.position.x, state->ship.position.y, state->ship.rotation);
             PlayShootSound();
             break;
         }
@@ -260,49 +410,29 @@ void CheckCollisions(GameState* state) {
     for (int i = 0; i < MAX_BULLETS; i++) {
         if (!state->bullets[i].isActive) continue;
         
-        for (int j = 0; j < MAX_ASTEROIDS; j++) {
-            if (!state->asteroids[j].isActive) continue;
-            
-            if (CheckCollisionCircles(state->bullets[i].position, BULLET_RADIUS,
-                                     state->asteroids[j].position, state->asteroids[j].radius)) {
-                
-                if (state->bullets[i].fromPlayer) {
-                    UpdateScore(state, GetAsteroidPoints(state->asteroids[j].size));
-                }
-                
-                if (state->asteroids[j].size != ASTEROID_SMALL) {
-                    for (int k = 0; k < MAX_ASTEROIDS; k++) {
-                        if (!state->asteroids[k].isActive) {
-                            for (int l = k + 1; l < MAX_ASTEROIDS; l++) {
-                                if (!state->asteroids[l].isActive) {
-                                    SplitAsteroid(&state->asteroids[j], 
-                                                &state->asteroids[k], 
-                                                &state->asteroids[l]);
-                                    state->asteroidCount += 2;
-                                    break;
-                                }
-                            }
-                            break;
-                        }
-                    }
-                }
-                
-                DestroyAsteroid(&state->asteroids[j]);
-                DestroyBullet(&state->bullets[i]);
-                PlayExplosionSound();
-                state->asteroidCount--;
-                break;
+        int hit = QueryAsteroidHit(state, state->bullets[i].position, BULLET_RADIUS);
+        if (hit >= 0) {
+            int points = state->bullets[i].fromPlayer ? GetAsteroidPoints(state->asteroids[hit].size) : 0;
+            if (state->bullets[i].fromPlayer) {
+                UpdateScore(state, points);
             }
+            EmitTelemetry(TELEMETRY_ASTEROID_HIT, state->asteroids[hit].size,
+                          state->asteroids[hit].position.x, state->asteroids[hit].position.y, points);
+            ShatterAsteroid(state, hit);
+            DestroyBullet(&state->bullets[i]);
         }
         
         for (int j = 0; j < MAX_UFOS; j++) {
             if (!state->ufos[j].isActive) continue;
             
             if (state->bullets[i].fromPlayer &&
-                CheckCollisionCircles(state->bullets[i].position, BULLET_RADIUS,
-                                     state->ufos[j].position, UFO_SIZE)) {
+                CheckCirclesOverlap(state->bullets[i].position, BULLET_RADIUS,
+                                   state->ufos[j].position, UFO_SIZE)) {
                 
                 UpdateScore(state, GetUFOPoints(state->ufos[j].type));
+                EmitTelemetry(TELEMETRY_UFO_DESTROYED, state->ufos[j].type,
+                              state->ufos[j].position.x, state->ufos[j].position.y, GetUFOPoints(state->ufos[j].type));
+                EmitExplosionParticles(state->ufos[j].position, state->ufos[j].velocity, UFO_EXPLOSION_PARTICLES);
                 DestroyUFO(&state->ufos[j]);
                 DestroyBullet(&state->bullets[i]);
                 PlayExplosionSound();
@@ -311,9 +441,11 @@ void CheckCollisions(GameState* state) {
         }
         
         if (!state->bullets[i].fromPlayer && state->ship.isAlive && !IsSpaceshipInvulnerable(&state->ship)) {
-            if (CheckCollisionCircles(state->bullets[i].position, BULLET_RADIUS,
-                                     state->ship.position, SPACESHIP_SIZE)) {
+            if (CheckCirclesOverlap(state->bullets[i].position, BULLET_RADIUS,
+                                   state->ship.position, SPACESHIP_SIZE)) {
                 state->ship.isAlive = false;
+                EmitTelemetry(TELEMETRY_SHIP_DESTROYED, TELEMETRY_CAUSE_BULLET, state->ship.position.x, state->ship.position.y, 0);
+                EmitExplosionParticles(state->ship.position, state->ship.velocity, SHIP_EXPLOSION_PARTICLES);
                 DestroyBullet(&state->bullets[i]);
                 PlayExplosionSound();
             }
@@ -321,23 +453,22 @@ void CheckCollisions(GameState* state) {
     }
     
     if (state->ship.isAlive && !IsSpaceshipInvulnerable(&state->ship)) {
-        for (int i = 0; i < MAX_ASTEROIDS; i++) {
-            if (!state->asteroids[i].isActive) continue;
-            
-            if (CheckCollisionCircles(state->ship.position, SPACESHIP_SIZE,
-                                     state->asteroids[i].position, state->asteroids[i].radius)) {
-                state->ship.isAlive = false;
-                PlayExplosionSound();
-                break;
-            }
+        if (QueryShipAsteroidHit(state) >= 0) {
+            state->ship.isAlive = false;
+            EmitTelemetry(TELEMETRY_SHIP_DESTROYED, TELEMETRY_CAUSE_ASTEROID, state->ship.position.x, state->ship.position.y, 0);
+            EmitExplosionParticles(state->ship.position, state->ship.velocity, SHIP_EXPLOSION_PARTICLES);
+            PlayExplosionSound();
         }
         
         for (int i = 0; i < MAX_UFOS; i++) {
             if (!state->ufos[i].isActive) continue;
             
-            if (CheckCollisionCircles(state->ship.position, SPACESHIP_SIZE,
-                                     state->ufos[i].position, UFO_SIZE)) {
+            if (CheckCirclesOverlap(state->ship.position, SPACESHIP_SIZE,
+                                   state->ufos[i].position, UFO_SIZE)) {
                 state->ship.isAlive = false;
+                EmitTelemetry(TELEMETRY_SHIP_DESTROYED, TELEMETRY_CAUSE_UFO, state->ship.position.x, state->ship.position.y, 0);
+                EmitExplosionParticles(state->ship.position, state->ship.velocity, SHIP_EXPLOSION_PARTICLES);
+                EmitExplosionParticles(state->ufos[i].position, state->ufos[i].velocity, UFO_EXPLOSION_PARTICLES);
                 DestroyUFO(&state->ufos[i]);
                 PlayExplosionSound();
                 break;
@@ -346,6 +477,39 @@ void CheckCollisions(GameState* state) {
     }
 }
 
+// Splits an asteroid into the first two free slots, or just destroys it
+// when it is small or the slots are full
+void ShatterAsteroid(GameState* state, int index) {
+    Asteroid* asteroid = &state->asteroids[index];
+    
+    if (asteroid->size != ASTEROID_SMALL) {
+        for (int k = 0; k < state->maxAsteroids; k++) {
+            if (!state->asteroids[k].isActive) {
+                for (int l = k + 1; l < state->maxAsteroids; l++) {
+                    if (!state->asteroids[l].isActive) {
+                        SplitAsteroid(asteroid, 
+                                    &state->asteroids[k], 
+                                    &state->asteroids[l]);
+                        TrackWorldAsteroid(state, k);
+                        TrackWorldAsteroid(state, l);
+                        state->asteroidCount += 2;
+                        EmitTelemetry(TELEMETRY_ASTEROID_SPLIT, asteroid->size,
+                                      asteroid->position.x, asteroid->position.y, 2);
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+    }
+    
+    EmitExplosionParticles(asteroid->position, asteroid->velocity, GetAsteroidExplosionParticles(asteroid->size));
+    DestroyAsteroid(asteroid);
+    UntrackWorldAsteroid(state, index);
+    PlayExplosionSound();
+    state->asteroidCount--;
+}
+
 void UpdateScore(GameState* state, int points) {
     state->score += points;
     if (state->score > state->highScore) {
@@ -360,25 +524,44 @@ void PauseGame(GameState* state) {
     }
 }
 
+// Controls held before the pause are dropped, so the resuming tick runs as if
+// no actions were applied, which is how a replay records it
 void ResumeGame(GameState* state) {
     if (state->state == GAME_STATE_PAUSED) {
         state->state = GAME_STATE_PLAYING;
+        state->ship.isThrusting = false;
+        state->ship.rotationSpeed = 0;
     }
 }
 
 void GameOver(GameState* state) {
     state->state = GAME_STATE_GAME_OVER;
+    EmitTelemetry(TELEMETRY_GAME_OVER, state->level, state->ship.position.x, state->ship.position.y, state->score);
 }
 
 int GetAsteroidPoints(AsteroidSize size) {
-    switch (size) {
-        case ASTEROID_LARGE: return 20;
-        case ASTEROID_MEDIUM: return 50;
-        case ASTEROID_SMALL: return 100;
-        default: return 0;
-    }
+    static const int points[ASTEROID_SIZE_COUNT] = {
+#define X(size, radius, value, particles) [size] = value,
+        ASTEROID_SIZE_TABLE(X)
+#undef X
+    };
+    return points[size];
+}
+
+int GetAsteroidExplosionParticles(AsteroidSize size) {
+    static const int particles[ASTEROID_SIZE_COUNT] = {
+#define X(size, radius, points, count) [size] = count,
+        ASTEROID_SIZE_TABLE(X)
+#undef X
+    };
+    return particles[size];
 }
 
 int GetUFOPoints(UFOType type) {
-    return (type == UFO_LARGE) ? 200 : 1000;
+    static const int points[] = {
+#define X(type, scale, value) [type] = value,
+        UFO_TYPE_TABLE(X)
+#undef X
+    };
+    return points[type];
 }
\ No newline at end of file
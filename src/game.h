@@ -2,7 +2,14 @@
 #define GAME_H
 
 #include "entities.h"
+#include "levels.h"
+#include "arena.h"
+#include "timers.h"
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define GAME_STATE_ALIGNMENT 64
 
 typedef enum {
     GAME_STATE_MENU,
@@ -11,9 +18,40 @@ typedef enum {
     GAME_STATE_GAME_OVER
 } GameStateType;
 
+// Per-tick ship controls; fire and hyperspace trigger once per tick they are set
+typedef enum {
+    ACTION_THRUST = 1 << 0,
+    ACTION_ROTATE_LEFT = 1 << 1,
+    ACTION_ROTATE_RIGHT = 1 << 2,
+    ACTION_FIRE = 1 << 3,
+    ACTION_HYPERSPACE = 1 << 4
+} ShipAction;
+
+// Stages of a playing tick, in the order UpdateGame runs them
+typedef enum {
+    GAME_PHASE_SHIP,
+    GAME_PHASE_ASTEROIDS,
+    GAME_PHASE_BULLETS,
+    GAME_PHASE_UFOS,
+    GAME_PHASE_COLLISIONS,
+    GAME_PHASE_EFFECTS,
+    GAME_PHASE_TIMERS,
+    GAME_PHASE_COUNT
+} GamePhase;
+
+// Seconds spent in each phase, added to by every tick while profiling
+typedef struct {
+    double seconds[GAME_PHASE_COUNT];
+} GamePhaseTimes;
+
+// Asteroid slots trail the struct so swarm games can size them at creation
+// while a whole state stays one contiguous block. Open-space worlds append
+// their chunk lists after the slots (see world.h). The block is the first
+// allocation in the session arena it points to.
 typedef struct {
+    Arena* arena;
+    
     Spaceship ship;
-    Asteroid asteroids[MAX_ASTEROIDS];
     Bullet bullets[MAX_BULLETS];
     UFO ufos[MAX_UFOS];
     
@@ -26,30 +64,59 @@ typedef struct {
     float screenWidth;
     float screenHeight;
     
-    float ufoSpawnTimer;
-    float nextUFOSpawn;
+    // Wrap extents; larger than the screen only in open-space worlds, where
+    // the camera (the world point at the centre of the view) follows the ship
+    float worldWidth;
+    float worldHeight;
+    Vector2 camera;
+    uint32_t tick;
     
-    float fireDelay;
-    float nextLevelDelay;
-    float respawnDelay;
+    // Fire cooldown, respawn and level delays, UFO spawns, invulnerability
+    // and each UFO's shooting and weaving, by TimerId
+    TimerWheel timers;
+    float nextUFOSpawn;
     
     bool showingHighScore;
+    
+    // Random state at the start of the game, enough to replay it from its inputs
+    uint64_t seed;
+    float playTime;
+    
+    LevelSetId levelSet;
+    int chunkColumns;
+    int chunkRows;
+    int maxAsteroids;
+    Asteroid asteroids[];
 } GameState;
 
 GameState* CreateGameState(float screenWidth, float screenHeight);
+GameState* CreateGameStateEx(float screenWidth, float screenHeight, int maxAsteroids);
+GameState* CreateWorldGameState(float screenWidth, float screenHeight, float worldWidth, float worldHeight,
+                                int maxAsteroids, size_t sessionBytes);
 void DestroyGameState(GameState* state);
+size_t GetGameStateSize(int maxAsteroids, int chunkCount);
+void CopyGameState(GameState* dest, const GameState* src);
+
+void* AllocateSessionMemory(GameState* state, size_t size, size_t alignment, MemoryTag tag);
+void WriteSessionMemoryReport(const GameState* state, FILE* out);
 
 void InitGame(GameState* state);
 void UpdateGame(GameState* state, float deltaTime);
+void SetGamePhaseProfile(GamePhaseTimes* times);
+const char* GetGamePhaseName(GamePhase phase);
 void DrawGame(const GameState* state);
 
 void StartNewGame(GameState* state);
 void StartNewLevel(GameState* state);
-void SpawnAsteroids(GameState* state, int count);
+void SpawnAsteroids(GameState* state, SpawnIndex* index, int count, AsteroidSize size);
 void SpawnUFO(GameState* state);
 
+void ApplyShipActions(GameState* state, unsigned int actions);
 void FireBullet(GameState* state);
+bool CanFireBullet(const GameState* state);
+float GetShipInvulnerableTime(const GameState* state);
 void CheckCollisions(GameState* state);
+void ShatterAsteroid(GameState* state, int index);
 void UpdateScore(GameState* state, int points);
 
 void PauseGame(GameState* state);
@@ -58,5 +125,6 @@ void GameOver(GameState* state);
 
 int GetAsteroidPoints(AsteroidSize size);
 int GetUFOPoints(UFOType type);
+int GetAsteroidExplosionParticles(AsteroidSize size);
 
 #endif
\ No newline at end of file
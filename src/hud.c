@@ -0,0 +1,206 @@
+#include "hud.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+
+#define HUD_LAYER_WIDTH 320
+#define HUD_LAYER_HEIGHT 120
+
+// Menu and game-over layers are composited relative to the screen centre
+#define SCREEN_LAYER_WIDTH 340
+#define SCREEN_LAYER_HEIGHT 150
+#define SCREEN_LAYER_OFFSET_X -170
+#define SCREEN_LAYER_OFFSET_Y -60
+
+#define LAYER_KEY_SIZE 4
+
+// Past this many lives the row collapses to a single icon and a count
+#define HUD_MAX_LIFE_ICONS 10
+
+typedef struct {
+    RenderTexture2D target;
+    int width;
+    int height;
+    int key[LAYER_KEY_SIZE];
+    bool valid;
+} HudLayer;
+
+typedef struct {
+    HudLayer hud;
+    HudLayer menu;
+    HudLayer gameOver;
+    HudLayer paused;
+} HudCache;
+
+static HudCache cache = {0};
+
+// Returns true when the layer has to be re-rasterized for the given key
+static bool PrepareLayer(HudLayer* layer, int width, int height, const int key[LAYER_KEY_SIZE]) {
+    if (layer->target.id == 0) {
+        layer->target = LoadRenderTexture(width, height);
+        layer->width = width;
+        layer->height = height;
+        layer->valid = false;
+    }
+    
+    if (layer->valid && memcmp(layer->key, key, sizeof(layer->key)) == 0) {
+        return false;
+    }
+    
+    memcpy(layer->key, key, sizeof(layer->key));
+    layer->valid = true;
+    return true;
+}
+
+static void UnloadLayer(HudLayer* layer) {
+    if (layer->target.id != 0) {
+        UnloadRenderTexture(layer->target);
+    }
+    *layer = (HudLayer){0};
+}
+
+static void DrawLayer(const HudLayer* layer, float x, float y) {
+    if (!layer->valid) return;
+    
+    // Render textures are stored upside down, flip them with a negative source height
+    Rectangle source = {0, 0, (float)layer->width, -(float)layer->height};
+    DrawTextureRec(layer->target.texture, source, (Vector2){x, y}, WHITE);
+}
+
+static void RasterizeHud(const GameState* state) {
+    char scoreText[32];
+    snprintf(scoreText, sizeof(scoreText), "Score: %d", state->score);
+    DrawText(scoreText, 10, 10, 20, WHITE);
+    
+    snprintf(scoreText, sizeof(scoreText), "High: %d", state->highScore);
+    DrawText(scoreText, 10, 35, 20, WHITE);
+    
+    snprintf(scoreText, sizeof(scoreText), "Level: %d", state->level);
+    DrawText(scoreText, 10, 60, 20, WHITE);
+    
+    int icons = state->ship.lives;
+    if (icons > HUD_MAX_LIFE_ICONS) {
+        icons = 1;
+        snprintf(scoreText, sizeof(scoreText), "x %d", state->ship.lives);
+        DrawText(scoreText, 50, 90, 20, WHITE);
+    }
+    
+    for (int i = 0; i < icons; i++) {
+        Vector2 p1 = {30.0f + i * 25, 90};
+        Vector2 p2 = {20.0f + i * 25, 105};
+        Vector2 p3 = {40.0f + i * 25, 105};
+        DrawLineV(p1, p2, WHITE);
+        DrawLineV(p2, p3, WHITE);
+        DrawLineV(p3, p1, WHITE);
+    }
+}
+
+static void RasterizePaused(void) {
+    int cx = -SCREEN_LAYER_OFFSET_X;
+    int cy = -SCREEN_LAYER_OFFSET_Y;
+    
+    DrawText("PAUSED", cx - 50, cy, 30, WHITE);
+}
+
+static void RasterizeMenu(void) {
+    int cx = -SCREEN_LAYER_OFFSET_X;
+    int cy = -SCREEN_LAYER_OFFSET_Y;
+    
+    DrawText("ASTEROIDS", cx - 100, cy - 50, 30, WHITE);
+    DrawText("Press SPACE to Start", cx - 110, cy, 20, WHITE);
+    DrawText("Press F1 for Help", cx - 70, cy + 50, 14, WHITE);
+}
+
+static void RasterizeGameOver(const GameState* state) {
+    int cx = -SCREEN_LAYER_OFFSET_X;
+    int cy = -SCREEN_LAYER_OFFSET_Y;
+    
+    DrawText("GAME OVER", cx - 80, cy - 50, 30, WHITE);
+    
+    char finalScore[64];
+    snprintf(finalScore, sizeof(finalScore), "Final Score: %d", state->score);
+    DrawText(finalScore, cx - 80, cy, 20, WHITE);
+    
+    if (state->showingHighScore) {
+        DrawText("NEW HIGH SCORE!", cx - 90, cy + 30, 20, YELLOW);
+    }
+    
+    DrawText("Press SPACE to Play Again", cx - 130, cy + 60, 20, WHITE);
+}
+
+void UpdateHudCache(const GameState* state) {
+    switch (state->state) {
+        case GAME_STATE_MENU: {
+            int key[LAYER_KEY_SIZE] = {0};
+            if (PrepareLayer(&cache.menu, SCREEN_LAYER_WIDTH, SCREEN_LAYER_HEIGHT, key)) {
+                BeginTextureMode(cache.menu.target);
+                    ClearBackground(BLANK);
+                    RasterizeMenu();
+                EndTextureMode();
+            }
+            break;
+        }
+            
+        case GAME_STATE_PLAYING:
+        case GAME_STATE_PAUSED: {
+            int key[LAYER_KEY_SIZE] = {state->score, state->highScore, state->level, state->ship.lives};
+            if (PrepareLayer(&cache.hud, HUD_LAYER_WIDTH, HUD_LAYER_HEIGHT, key)) {
+                BeginTextureMode(cache.hud.target);
+                    ClearBackground(BLANK);
+                    RasterizeHud(state);
+                EndTextureMode();
+            }
+            
+            if (state->state == GAME_STATE_PAUSED) {
+                int pausedKey[LAYER_KEY_SIZE] = {0};
+                if (PrepareLayer(&cache.paused, SCREEN_LAYER_WIDTH, SCREEN_LAYER_HEIGHT, pausedKey)) {
+                    BeginTextureMode(cache.paused.target);
+                        ClearBackground(BLANK);
+                        RasterizePaused();
+                    EndTextureMode();
+                }
+            }
+            break;
+        }
+            
+        case GAME_STATE_GAME_OVER: {
+            int key[LAYER_KEY_SIZE] = {state->score, state->showingHighScore, 0, 0};
+            if (PrepareLayer(&cache.gameOver, SCREEN_LAYER_WIDTH, SCREEN_LAYER_HEIGHT, key)) {
+                BeginTextureMode(cache.gameOver.target);
+                    ClearBackground(BLANK);
+                    RasterizeGameOver(state);
+                EndTextureMode();
+            }
+            break;
+        }
+    }
+}
+
+void UnloadHudCache(void) {
+    UnloadLayer(&cache.hud);
+    UnloadLayer(&cache.menu);
+    UnloadLayer(&cache.gameOver);
+    UnloadLayer(&cache.paused);
+}
+
+void DrawHud(void) {
+    DrawLayer(&cache.hud, 0, 0);
+}
+
+void DrawMenuScreen(const GameState* state) {
+    DrawLayer(&cache.menu,
+              (int)(state->screenWidth / 2) + SCREEN_LAYER_OFFSET_X,
+              (int)(state->screenHeight / 2) + SCREEN_LAYER_OFFSET_Y);
+}
+
+void DrawGameOverScreen(const GameState* state) {
+    DrawLayer(&cache.gameOver,
+              (int)(state->screenWidth / 2) + SCREEN_LAYER_OFFSET_X,
+              (int)(state->screenHeight / 2) + SCREEN_LAYER_OFFSET_Y);
+}
+
+void DrawPausedScreen(const GameState* state) {
+    DrawLayer(&cache.paused,
+              (int)(state->screenWidth / 2) + SCREEN_LAYER_OFFSET_X,
+              (int)(state->screenHeight / 2) + SCREEN_LAYER_OFFSET_Y);
+}
\ No newline at end of file
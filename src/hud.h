@@ -0,0 +1,14 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include "game.h"
+
+void UpdateHudCache(const GameState* state);
+void UnloadHudCache(void);
+
+void DrawHud(void);
+void DrawMenuScreen(const GameState* state);
+void DrawGameOverScreen(const GameState* state);
+void DrawPausedScreen(const GameState* state);
+
+#endif
\ No newline at end of file
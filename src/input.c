@@ -2,58 +2,105 @@
 #include "raylib.h"
 #include "audio.h"
 
-void ProcessInput(GameState* state) {
+static const struct {
+    int key;
+    InputButton button;
+} bindings[] = {
+    { KEY_UP, INPUT_THRUST },
+    { KEY_W, INPUT_THRUST },
+    { KEY_LEFT, INPUT_ROTATE_LEFT },
+    { KEY_A, INPUT_ROTATE_LEFT },
+    { KEY_RIGHT, INPUT_ROTATE_RIGHT },
+    { KEY_D, INPUT_ROTATE_RIGHT },
+    { KEY_SPACE, INPUT_FIRE },
+    { KEY_H, INPUT_HYPERSPACE },
+    { KEY_P, INPUT_PAUSE },
+    { KEY_ESCAPE, INPUT_PAUSE }
+};
+
+static void LatchInput(InputSample* sample) {
+    unsigned int down = 0;
+    for (size_t i = 0; i < sizeof(bindings) / sizeof(bindings[0]); i++) {
+        if (IsKeyDown(bindings[i].key)) down |= bindings[i].button;
+        if (IsKeyPressed(bindings[i].key)) sample->pressed |= bindings[i].button;
+    }
+    while (GetKeyPressed() != 0) {
+        sample->pressed |= INPUT_ANY_KEY;
+    }
+    sample->down = down;
+}
+
+// Another poll moves the last poll's keys into the previous state, so their
+// presses are latched before it or they would be lost
+void SampleInput(InputSample* sample, bool poll) {
+    sample->pressed = 0;
+    LatchInput(sample);
+    if (poll) {
+        PollInputEvents();
+        LatchInput(sample);
+    }
+    sample->time = GetTime();
+}
+
+unsigned int ProcessInput(GameState* state, const InputSample* input) {
+    unsigned int actions = 0;
+    
     switch (state->state) {
         case GAME_STATE_MENU:
-            if (IsKeyPressed(KEY_SPACE)) {
+            if (input->pressed & INPUT_FIRE) {
                 StartNewGame(state);
             }
             break;
             
-        case GAME_STATE_PLAYING:
-            state->ship.isThrusting = false;
-            state->ship.rotationSpeed = 0;
+        case GAME_STATE_PLAYING: {
+            // The pausing frame applies no controls, so every applied action belongs to a simulated tick
+            if (input->pressed & INPUT_PAUSE) {
+                StopThrustSound();
+                PauseGame(state);
+                break;
+            }
             
-            if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) {
-                ThrustSpaceship(&state->ship);
+            if (input->down & INPUT_THRUST) {
+                actions |= ACTION_THRUST;
                 PlayThrustSound();
             } else {
                 StopThrustSound();
             }
             
-            if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) {
-                RotateSpaceship(&state->ship, -1);
+            if (input->down & INPUT_ROTATE_LEFT) {
+                actions |= ACTION_ROTATE_LEFT;
             }
             
-            if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) {
-                RotateSpaceship(&state->ship, 1);
+            if (input->down & INPUT_ROTATE_RIGHT) {
+                actions |= ACTION_ROTATE_RIGHT;
             }
             
-            if (IsKeyPressed(KEY_SPACE)) {
-                FireBullet(state);
+            if (input->pressed & INPUT_FIRE) {
+                actions |= ACTION_FIRE;
             }
             
-            if (IsKeyPressed(KEY_H)) {
-                HyperspaceJump(&state->ship, state->screenWidth, state->screenHeight);
+            if (input->pressed & INPUT_HYPERSPACE) {
+                actions |= ACTION_HYPERSPACE;
                 PlayHyperspaceSound();
             }
             
-            if (IsKeyPressed(KEY_P) || IsKeyPressed(KEY_ESCAPE)) {
-                PauseGame(state);
-            }
+            ApplyShipActions(state, actions);
             break;
+        }
             
         case GAME_STATE_PAUSED:
-            if (IsKeyPressed(KEY_P) || IsKeyPressed(KEY_ESCAPE)) {
+            if (input->pressed & INPUT_PAUSE) {
                 ResumeGame(state);
             }
             break;
             
         case GAME_STATE_GAME_OVER:
-            if (IsKeyPressed(KEY_SPACE)) {
+            if (input->pressed & INPUT_FIRE) {
                 state->showingHighScore = false;
                 StartNewGame(state);
             }
             break;
     }
+    
+    return actions;
 }
\ No newline at end of file
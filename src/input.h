@@ -2,7 +2,31 @@
 #define INPUT_H
 
 #include "game.h"
+#include <stdbool.h>
 
-void ProcessInput(GameState* state);
+typedef enum {
+    INPUT_THRUST = 1 << 0,
+    INPUT_ROTATE_LEFT = 1 << 1,
+    INPUT_ROTATE_RIGHT = 1 << 2,
+    INPUT_FIRE = 1 << 3,
+    INPUT_HYPERSPACE = 1 << 4,
+    INPUT_PAUSE = 1 << 5,
+    INPUT_ANY_KEY = 1 << 6
+} InputButton;
 
-#endif
\ No newline at end of file
+// The controls as of one moment, latched so a frame reads them all at once
+typedef struct {
+    unsigned int down;
+    unsigned int pressed;
+    double time;
+} InputSample;
+
+// Latches the input raylib polled at the end of the last frame. With poll
+// set it then polls again and takes the newer state, keeping any presses
+// the first poll saw, so input can be sampled just before the simulation.
+void SampleInput(InputSample* sample, bool poll);
+
+// Returns the ship actions applied this frame, for replay recording
+unsigned int ProcessInput(GameState* state, const InputSample* input);
+
+#endif
@@ -0,0 +1,252 @@
+#include "instancing.h"
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <stdint.h>
+#include <string.h>
+
+#define ASTEROID_INSTANCE_CAPACITY 4096
+#define INSTANCE_FLOATS 4
+#define TEMPLATE_VERTEX_FLOATS 4
+#define VERTICES_PER_EDGE 6
+#define ASTEROID_LINE_HALF_WIDTH 0.5f
+
+// rlSetVertexAttribute() takes a byte offset since raylib 5.5 and a pointer before that
+#if RAYLIB_VERSION_MAJOR > 5 || (RAYLIB_VERSION_MAJOR == 5 && RAYLIB_VERSION_MINOR >= 5)
+    #define ATTRIB_OFFSET(bytes) ((int)(bytes))
+#else
+    #define ATTRIB_OFFSET(bytes) ((const void*)(uintptr_t)(bytes))
+#endif
+
+static const char* asteroidVertexShader =
+    "in vec2 vertexPosition;\n"
+    "in vec2 vertexNormal;\n"
+    "in vec4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "uniform float lineHalfWidth;\n"
+    "void main() {\n"
+    "    float c = cos(instanceTransform.z);\n"
+    "    float s = sin(instanceTransform.z);\n"
+    "    vec2 local = vertexPosition * instanceTransform.w + vertexNormal * lineHalfWidth;\n"
+    "    vec2 world = vec2(local.x * c - local.y * s, local.x * s + local.y * c) + instanceTransform.xy;\n"
+    "    gl_Position = mvp * vec4(world, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* asteroidFragmentShader =
+    "uniform vec4 lineColor;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = lineColor;\n"
+    "}\n";
+
+typedef struct {
+    bool ready;
+    unsigned int shader;
+    unsigned int vao;
+    unsigned int templateVbo;
+    unsigned int instanceVbo;
+    int mvpLoc;
+    int halfWidthLoc;
+    int colorLoc;
+    int instanceLoc;
+    int templateFirst[ASTEROID_SHAPE_TEMPLATES];
+    int templateVertexCount[ASTEROID_SHAPE_TEMPLATES];
+    int groupCount[ASTEROID_SHAPE_TEMPLATES];
+    int groupStart[ASTEROID_SHAPE_TEMPLATES];
+    float instances[ASTEROID_INSTANCE_CAPACITY * INSTANCE_FLOATS];
+} AsteroidInstancing;
+
+static AsteroidInstancing instancing = {0};
+
+static char* ComposeShaderSource(char* buffer, size_t size, const char* header, const char* body) {
+    buffer[0] = '\0';
+    strncat(buffer, header, size - 1);
+    strncat(buffer, body, size - strlen(buffer) - 1);
+    return buffer;
+}
+
+// Each outline edge becomes a thin quad extruded along its normal so that the
+// whole atlas can be drawn with triangles through rlDrawVertexArrayInstanced()
+static int BuildTemplateVertices(float* vertices) {
+    int vertexCount = 0;
+    
+    for (int t = 0; t < ASTEROID_SHAPE_TEMPLATES; t++) {
+        const AsteroidShape* shape = GetAsteroidShape(t);
+        instancing.templateFirst[t] = vertexCount;
+        
+        for (int i = 0; i < shape->pointCount; i++) {
+            Vector2 a = shape->points[i];
+            Vector2 b = shape->points[(i + 1) % shape->pointCount];
+            Vector2 n = Vector2Normalize((Vector2){-(b.y - a.y), b.x - a.x});
+            
+            const float corners[VERTICES_PER_EDGE][2] = {
+                {0, -1}, {1, -1}, {1, 1},
+                {0, -1}, {1, 1}, {0, 1}
+            };
+            
+            for (int c = 0; c < VERTICES_PER_EDGE; c++) {
+                Vector2 p = (corners[c][0] == 0) ? a : b;
+                float side = corners[c][1];
+                float* v = &vertices[vertexCount * TEMPLATE_VERTEX_FLOATS];
+                v[0] = p.x;
+                v[1] = p.y;
+                v[2] = n.x * side;
+                v[3] = n.y * side;
+                vertexCount++;
+            }
+        }
+        
+        instancing.templateVertexCount[t] = vertexCount - instancing.templateFirst[t];
+    }
+    
+    return vertexCount;
+}
+
+void InitAsteroidInstancing(void) {
+    if (instancing.ready) return;
+    
+    const char* header;
+    switch (rlGetVersion()) {
+        case RL_OPENGL_33:
+        case RL_OPENGL_43:
+            header = "#version 330\n";
+            break;
+        case RL_OPENGL_ES_30:
+            header = "#version 300 es\nprecision mediump float;\n";
+            break;
+        default:
+            TraceLog(LOG_INFO, "ASTEROIDS: Instancing unavailable, using CPU outlines");
+            return;
+    }
+    
+    char vsCode[1024];
+    char fsCode[512];
+    ComposeShaderSource(vsCode, sizeof(vsCode), header, asteroidVertexShader);
+    ComposeShaderSource(fsCode, sizeof(fsCode), header, asteroidFragmentShader);
+    
+    instancing.shader = rlLoadShaderCode(vsCode, fsCode);
+    if (instancing.shader == 0) {
+        TraceLog(LOG_WARNING, "ASTEROIDS: Failed to compile instancing shader, using CPU outlines");
+        return;
+    }
+    
+    instancing.mvpLoc = rlGetLocationUniform(instancing.shader, "mvp");
+    instancing.halfWidthLoc = rlGetLocationUniform(instancing.shader, "lineHalfWidth");
+    instancing.colorLoc = rlGetLocationUniform(instancing.shader, "lineColor");
+    int positionLoc = rlGetLocationAttrib(instancing.shader, "vertexPosition");
+    int normalLoc = rlGetLocationAttrib(instancing.shader, "vertexNormal");
+    instancing.instanceLoc = rlGetLocationAttrib(instancing.shader, "instanceTransform");
+    
+    static float templateVertices[ASTEROID_SHAPE_TEMPLATES * MAX_ASTEROID_VERTICES * VERTICES_PER_EDGE * TEMPLATE_VERTEX_FLOATS];
+    int vertexCount = BuildTemplateVertices(templateVertices);
+    int stride = TEMPLATE_VERTEX_FLOATS * sizeof(float);
+    
+    instancing.vao = rlLoadVertexArray();
+    rlEnableVertexArray(instancing.vao);
+    
+    instancing.templateVbo = rlLoadVertexBuffer(templateVertices, vertexCount * stride, false);
+    rlSetVertexAttribute(positionLoc, 2, RL_FLOAT, false, stride, ATTRIB_OFFSET(0));
+    rlEnableVertexAttribute(positionLoc);
+    rlSetVertexAttribute(normalLoc, 2, RL_FLOAT, false, stride, ATTRIB_OFFSET(2 * sizeof(float)));
+    rlEnableVertexAttribute(normalLoc);
+    
+    instancing.instanceVbo = rlLoadVertexBuffer(nullptr, sizeof(instancing.instances), true);
+    rlSetVertexAttribute(instancing.instanceLoc, INSTANCE_FLOATS, RL_FLOAT, false, 0, ATTRIB_OFFSET(0));
+    rlEnableVertexAttribute(instancing.instanceLoc);
+    rlSetVertexAttributeDivisor(instancing.instanceLoc, 1);
+    
+    rlDisableVertexArray();
+    
+    instancing.ready = true;
+}
+
+void UnloadAsteroidInstancing(void) {
+    if (!instancing.ready) return;
+    
+    rlUnloadVertexBuffer(instancing.instanceVbo);
+    rlUnloadVertexBuffer(instancing.templateVbo);
+    rlUnloadVertexArray(instancing.vao);
+    rlUnloadShaderProgram(instancing.shader);
+    instancing.ready = false;
+}
+
+bool IsAsteroidInstancingReady(void) {
+    return instancing.ready;
+}
+
+// Writes one chunk of asteroids into the instance buffer grouped by shape template
+static int PackInstances(const Asteroid* asteroids, int count) {
+    memset(instancing.groupCount, 0, sizeof(instancing.groupCount));
+    for (int i = 0; i < count; i++) {
+        if (asteroids[i].isActive) {
+            instancing.groupCount[asteroids[i].shapeIndex]++;
+        }
+    }
+    
+    int total = 0;
+    int cursor[ASTEROID_SHAPE_TEMPLATES];
+    for (int t = 0; t < ASTEROID_SHAPE_TEMPLATES; t++) {
+        instancing.groupStart[t] = total;
+        cursor[t] = total;
+        total += instancing.groupCount[t];
+    }
+    
+    for (int i = 0; i < count; i++) {
+        const Asteroid* asteroid = &asteroids[i];
+        if (!asteroid->isActive) continue;
+        
+        float* instance = &instancing.instances[cursor[asteroid->shapeIndex]++ * INSTANCE_FLOATS];
+        instance[0] = asteroid->position.x;
+        instance[1] = asteroid->position.y;
+        instance[2] = asteroid->rotation * DEG2RAD;
+        instance[3] = asteroid->radius;
+    }
+    
+    return total;
+}
+
+void DrawAsteroidsInstanced(const Asteroid* asteroids, int count) {
+    if (!instancing.ready) {
+        for (int i = 0; i < count; i++) {
+            DrawAsteroid(&asteroids[i]);
+        }
+        return;
+    }
+    
+    // Flush raylib's own batch so the outlines keep their place in draw order
+    rlDrawRenderBatchActive();
+    
+    Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+    float halfWidth = ASTEROID_LINE_HALF_WIDTH;
+    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    
+    rlEnableShader(instancing.shader);
+    rlSetUniformMatrix(instancing.mvpLoc, mvp);
+    rlSetUniform(instancing.halfWidthLoc, &halfWidth, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(instancing.colorLoc, color, RL_SHADER_UNIFORM_VEC4, 1);
+    rlEnableVertexArray(instancing.vao);
+    
+    for (int first = 0; first < count; first += ASTEROID_INSTANCE_CAPACITY) {
+        int chunk = count - first;
+        if (chunk > ASTEROID_INSTANCE_CAPACITY) chunk = ASTEROID_INSTANCE_CAPACITY;
+        
+        int total = PackInstances(&asteroids[first], chunk);
+        if (total == 0) continue;
+        
+        rlUpdateVertexBuffer(instancing.instanceVbo, instancing.instances, total * INSTANCE_FLOATS * sizeof(float), 0);
+        
+        for (int t = 0; t < ASTEROID_SHAPE_TEMPLATES; t++) {
+            if (instancing.groupCount[t] == 0) continue;
+            
+            rlEnableVertexBuffer(instancing.instanceVbo);
+            rlSetVertexAttribute(instancing.instanceLoc, INSTANCE_FLOATS, RL_FLOAT, false, 0,
+                                 ATTRIB_OFFSET(instancing.groupStart[t] * INSTANCE_FLOATS * sizeof(float)));
+            rlDrawVertexArrayInstanced(instancing.templateFirst[t], instancing.templateVertexCount[t],
+                                       instancing.groupCount[t]);
+        }
+    }
+    
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableShader();
+}
\ No newline at end of file
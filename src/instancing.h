@@ -0,0 +1,12 @@
+#ifndef INSTANCING_H
+#define INSTANCING_H
+
+#include "entities.h"
+
+void InitAsteroidInstancing(void);
+void UnloadAsteroidInstancing(void);
+bool IsAsteroidInstancingReady(void);
+
+void DrawAsteroidsInstanced(const Asteroid* asteroids, int count);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#define _POSIX_C_SOURCE 200809L
+#include "jobs.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct JobPool {
+    pthread_t* threads;
+    int workerCount;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t finished;
+    JobFunction function;
+    void* context;
+    int count;
+    atomic_int next;
+    int busyWorkers;
+    unsigned int generation;
+    bool quit;
+};
+
+static void DrainJobs(JobPool* pool) {
+    for (;;) {
+        int index = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed);
+        if (index >= pool->count) break;
+        pool->function(pool->context, index);
+    }
+}
+
+static void* JobWorker(void* arg) {
+    JobPool* pool = arg;
+    unsigned int seen = 0;
+    
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->quit) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->quit) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        
+        DrainJobs(pool);
+        
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busyWorkers == 0) {
+            pthread_cond_signal(&pool->finished);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    
+    return nullptr;
+}
+
+JobPool* CreateJobPool(int workerCount) {
+    JobPool* pool = calloc(1, sizeof(JobPool));
+    if (!pool) return nullptr;
+    
+    if (workerCount < 0) workerCount = 0;
+    
+    pthread_mutex_init(&pool->lock, nullptr);
+    pthread_cond_init(&pool->wake, nullptr);
+    pthread_cond_init(&pool->finished, nullptr);
+    
+    if (workerCount > 0) {
+        pool->threads = calloc(workerCount, sizeof(pthread_t));
+        if (!pool->threads) {
+            DestroyJobPool(pool);
+            return nullptr;
+        }
+    }
+    
+    for (int i = 0; i < workerCount; i++) {
+        if (pthread_create(&pool->threads[i], nullptr, JobWorker, pool) != 0) break;
+        pool->workerCount++;
+    }
+    
+    return pool;
+}
+
+void DestroyJobPool(JobPool* pool) {
+    if (!pool) return;
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (int i = 0; i < pool->workerCount; i++) {
+        pthread_join(pool->threads[i], nullptr);
+    }
+    
+    pthread_cond_destroy(&pool->finished);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+// Indices are handed out dynamically, so callers must not rely on which thread runs which index
+void RunJobs(JobPool* pool, JobFunction function, void* context, int count) {
+    if (count <= 0) return;
+    
+    if (!pool || pool->workerCount == 0 || count == 1) {
+        for (int i = 0; i < count; i++) {
+            function(context, i);
+        }
+        return;
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->function = function;
+    pool->context = context;
+    pool->count = count;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    pool->busyWorkers = pool->workerCount;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    
+    DrainJobs(pool);
+    
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busyWorkers > 0) {
+        pthread_cond_wait(&pool->finished, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int GetJobPoolWorkerCount(const JobPool* pool) {
+    return pool ? pool->workerCount : 0;
+}
+
+int GetHardwareThreadCount(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+// Persistent worker pool running parallel-for style batches. The calling
+// thread takes part in every batch, so a pool of 0 workers runs inline.
+
+typedef void (*JobFunction)(void* context, int index);
+
+typedef struct JobPool JobPool;
+
+JobPool* CreateJobPool(int workerCount);
+void DestroyJobPool(JobPool* pool);
+
+void RunJobs(JobPool* pool, JobFunction function, void* context, int count);
+int GetJobPoolWorkerCount(const JobPool* pool);
+int GetHardwareThreadCount(void);
+
+#endif
\ No newline at end of file
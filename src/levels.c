@@ -0,0 +1,150 @@
+#include "levels.h"
+#include "utils.h"
+#include "raymath.h"
+#include <math.h>
+
+#define SPAWN_MAX_CELLS 8192
+#define SPAWN_MIN_CELL_SIZE 16.0f
+#define SPAWN_CELLS_PER_ASTEROID 2.0f
+#define SPAWN_JITTER 0.8f
+#define SPAWN_MAX_TRIES 4
+
+static const LevelDefinition classicLevels[] = {
+    { 4, 0, 100.0f, 0.9f },
+    { 6, 0, 100.0f, 0.8f },
+    { 8, 0, 100.0f, 0.7f },
+    { 10, 0, 100.0f, 0.6f },
+    { 12, 0, 100.0f, 0.5f }
+};
+
+// Swarm levels only fill up on a state created with MAX_SWARM_ASTEROIDS slots
+static const LevelDefinition swarmLevels[] = {
+    { 8, 300, 240.0f, 0.9f },
+    { 10, 800, 240.0f, 0.8f },
+    { 12, 1500, 260.0f, 0.7f },
+    { 16, 2500, 280.0f, 0.6f },
+    { 20, 3500, 300.0f, 0.5f }
+};
+
+// Open space spreads its asteroids over a world many screens across
+static const LevelDefinition openSpaceLevels[] = {
+    { 150, 600, 300.0f, 0.9f },
+    { 200, 1200, 300.0f, 0.8f },
+    { 250, 1800, 300.0f, 0.7f },
+    { 300, 2400, 300.0f, 0.6f },
+    { 400, 3000, 300.0f, 0.5f }
+};
+
+typedef struct {
+    const LevelDefinition* levels;
+    int count;
+} LevelSet;
+
+static const LevelSet levelSets[LEVEL_SET_COUNT] = {
+    [LEVEL_SET_CLASSIC] = { classicLevels, sizeof(classicLevels) / sizeof(classicLevels[0]) },
+    [LEVEL_SET_SWARM] = { swarmLevels, sizeof(swarmLevels) / sizeof(swarmLevels[0]) },
+    [LEVEL_SET_OPEN_SPACE] = { openSpaceLevels, sizeof(openSpaceLevels) / sizeof(openSpaceLevels[0]) }
+};
+
+// Headless sessions build levels on worker threads, so each thread gets its own cell list
+static thread_local int spawnCells[SPAWN_MAX_CELLS];
+
+const LevelDefinition* GetLevelDefinition(LevelSetId set, int level) {
+    const LevelSet* levelSet = &levelSets[(set >= 0 && set < LEVEL_SET_COUNT) ? set : LEVEL_SET_CLASSIC];
+    int row = level - 1;
+    if (row < 0) row = 0;
+    if (row >= levelSet->count) row = levelSet->count - 1;
+    return &levelSet->levels[row];
+}
+
+int GetLevelAsteroidTotal(const LevelDefinition* definition) {
+    return definition->largeAsteroids + definition->smallAsteroids;
+}
+
+static Vector2 GetCellCenter(const SpawnIndex* index, int cell) {
+    return (Vector2){
+        (cell % index->columns + 0.5f) * index->cellWidth,
+        (cell / index->columns + 0.5f) * index->cellHeight
+    };
+}
+
+static bool IsOutsideSafeZone(const SpawnIndex* index, Vector2 point) {
+    Vector2 offset = GetWrappedOffset(index->avoid, point, index->width, index->height);
+    return Vector2Length(offset) >= index->safeRadius;
+}
+
+// The corner of the cell's jitter box farthest from the ship, which is the
+// point most likely to clear the safe zone
+static Vector2 GetFarthestSpawnPoint(const SpawnIndex* index, Vector2 center) {
+    Vector2 offset = GetWrappedOffset(index->avoid, center, index->width, index->height);
+    float reachX = 0.5f * SPAWN_JITTER * index->cellWidth;
+    float reachY = 0.5f * SPAWN_JITTER * index->cellHeight;
+    return (Vector2){
+        center.x + (offset.x < 0 ? -reachX : reachX),
+        center.y + (offset.y < 0 ? -reachY : reachY)
+    };
+}
+
+void BuildSpawnIndex(SpawnIndex* index, float width, float height, int count, Vector2 avoid, float safeRadius) {
+    if (count < 1) count = 1;
+    
+    // Aim for a couple of cells per asteroid so rocks rarely share a cell
+    float cellSize = sqrtf(width * height / (count * SPAWN_CELLS_PER_ASTEROID));
+    if (cellSize < SPAWN_MIN_CELL_SIZE) cellSize = SPAWN_MIN_CELL_SIZE;
+    
+    int columns = (int)(width / cellSize);
+    int rows = (int)(height / cellSize);
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+    while (columns * rows > SPAWN_MAX_CELLS) {
+        columns = (columns + 1) / 2;
+        rows = (rows + 1) / 2;
+    }
+    
+    index->cellWidth = width / columns;
+    index->cellHeight = height / rows;
+    index->columns = columns;
+    index->cells = spawnCells;
+    index->drawn = 0;
+    index->freeCount = 0;
+    index->width = width;
+    index->height = height;
+    index->avoid = avoid;
+    index->safeRadius = safeRadius;
+    
+    // A cell is free when some point it can place lies outside the safe radius
+    for (int cell = 0; cell < columns * rows; cell++) {
+        if (IsOutsideSafeZone(index, GetFarthestSpawnPoint(index, GetCellCenter(index, cell)))) {
+            spawnCells[index->freeCount++] = cell;
+        }
+    }
+    
+    // A playfield smaller than the safe zone still gets asteroids rather than none
+    if (index->freeCount == 0) {
+        for (int cell = 0; cell < columns * rows; cell++) {
+            spawnCells[index->freeCount++] = cell;
+        }
+        index->safeRadius = 0;
+    }
+}
+
+// Partial Fisher-Yates over the free cells; once every cell is used the pass starts again
+Vector2 NextSpawnPosition(SpawnIndex* index) {
+    int slot = index->drawn % index->freeCount;
+    int pick = RandomInt(slot, index->freeCount - 1);
+    
+    int cell = index->cells[pick];
+    index->cells[pick] = index->cells[slot];
+    index->cells[slot] = cell;
+    index->drawn++;
+    
+    // The draws are sequenced so every compiler consumes the random stream alike
+    Vector2 center = GetCellCenter(index, cell);
+    for (int attempt = 0; attempt < SPAWN_MAX_TRIES; attempt++) {
+        float jitterX = RandomFloat(-0.5f, 0.5f) * SPAWN_JITTER;
+        float jitterY = RandomFloat(-0.5f, 0.5f) * SPAWN_JITTER;
+        Vector2 point = { center.x + jitterX * index->cellWidth, center.y + jitterY * index->cellHeight };
+        if (IsOutsideSafeZone(index, point)) return point;
+    }
+    return GetFarthestSpawnPoint(index, center);
+}
@@ -0,0 +1,48 @@
+#ifndef LEVELS_H
+#define LEVELS_H
+
+#include "entities.h"
+
+// Level progression is table driven: each set lists its levels in order and
+// the last row repeats once a game runs past the end of the table.
+
+typedef enum {
+    LEVEL_SET_CLASSIC,
+    LEVEL_SET_SWARM,
+    LEVEL_SET_OPEN_SPACE,
+    LEVEL_SET_COUNT
+} LevelSetId;
+
+typedef struct {
+    int largeAsteroids;
+    int smallAsteroids;
+    float safeRadius;
+    // Fraction of the tuning table's ufoBaseSpawnTime between UFOs
+    float ufoSpawnScale;
+} LevelDefinition;
+
+// Free-space grid over the playfield. Cells wholly inside the ship's safe
+// zone are removed. A point drawn inside the zone from a partly covered cell
+// is drawn again a few times before it moves to the cell's far corner.
+// Positions come from shuffled free cells, so placing N asteroids costs
+// O(cells + N) no matter how crowded or small the playfield is.
+typedef struct {
+    float cellWidth;
+    float cellHeight;
+    int columns;
+    int freeCount;
+    int drawn;
+    int* cells;
+    float width;
+    float height;
+    Vector2 avoid;
+    float safeRadius;
+} SpawnIndex;
+
+const LevelDefinition* GetLevelDefinition(LevelSetId set, int level);
+int GetLevelAsteroidTotal(const LevelDefinition* definition);
+
+void BuildSpawnIndex(SpawnIndex* index, float width, float height, int count, Vector2 avoid, float safeRadius);
+Vector2 NextSpawnPosition(SpawnIndex* index);
+
+#endif
@@ -0,0 +1,161 @@
+#include "lookahead.h"
+#include "jobs.h"
+#include "utils.h"
+#include <stdlib.h>
+
+#define LOOKAHEAD_TICK_DT (1.0f / 60.0f)
+#define LOOKAHEAD_DEATH_PENALTY 2000.0f
+#define LOOKAHEAD_RANDOM_HOLD_TICKS 8
+#define LOOKAHEAD_SEED_STRIDE 0x9E3779B97F4A7C15ULL
+#define LOOKAHEAD_CLONE_ALIGNMENT 64
+
+// Hyperspace is only ever tried as the committed first action
+static const unsigned int candidateActions[] = {
+    0,
+    ACTION_FIRE,
+    ACTION_THRUST,
+    ACTION_THRUST | ACTION_FIRE,
+    ACTION_ROTATE_LEFT,
+    ACTION_ROTATE_LEFT | ACTION_FIRE,
+    ACTION_ROTATE_RIGHT,
+    ACTION_ROTATE_RIGHT | ACTION_FIRE,
+    ACTION_THRUST | ACTION_ROTATE_LEFT,
+    ACTION_THRUST | ACTION_ROTATE_RIGHT,
+    ACTION_HYPERSPACE
+};
+
+#define CANDIDATE_COUNT ((int)(sizeof(candidateActions) / sizeof(candidateActions[0])))
+
+struct Lookahead {
+    LookaheadConfig config;
+    JobPool* jobs;
+    unsigned char* clones;
+    size_t cloneStride;
+    float* values;
+    const GameState* root;
+    uint64_t seed;
+};
+
+LookaheadConfig GetDefaultLookaheadConfig(void) {
+    return (LookaheadConfig){
+        .rollouts = LOOKAHEAD_DEFAULT_ROLLOUTS,
+        .horizon = LOOKAHEAD_DEFAULT_HORIZON,
+        .commitTicks = LOOKAHEAD_DEFAULT_COMMIT_TICKS,
+        .workerCount = GetHardwareThreadCount() - 1
+    };
+}
+
+Lookahead* CreateLookahead(const LookaheadConfig* config) {
+    if (config->rollouts <= 0 || config->horizon <= 0) return nullptr;
+    
+    Lookahead* lookahead = calloc(1, sizeof(Lookahead));
+    if (!lookahead) return nullptr;
+    
+    lookahead->config = *config;
+    lookahead->values = malloc(sizeof(float) * config->rollouts);
+    if (!lookahead->values) {
+        DestroyLookahead(lookahead);
+        return nullptr;
+    }
+    
+    if (config->workerCount > 0) {
+        lookahead->jobs = CreateJobPool(config->workerCount);
+    }
+    
+    return lookahead;
+}
+
+void DestroyLookahead(Lookahead* lookahead) {
+    if (!lookahead) return;
+    DestroyJobPool(lookahead->jobs);
+    free(lookahead->clones);
+    free(lookahead->values);
+    free(lookahead);
+}
+
+static void RunRollout(void* context, int index) {
+    Lookahead* lookahead = context;
+    const LookaheadConfig* config = &lookahead->config;
+    GameState* state = (GameState*)(lookahead->clones + index * lookahead->cloneStride);
+    
+    // The calling thread runs rollouts too, so its own stream and effects are restored afterwards
+    uint64_t savedRandom = GetRandomState();
+    bool savedEffects = AreEffectsEnabled();
+    SeedRandom(lookahead->seed + (uint64_t)index * LOOKAHEAD_SEED_STRIDE);
+    SetEffectsEnabled(false);
+    
+    CopyGameState(state, lookahead->root);
+    
+    int startScore = state->score;
+    int startLives = state->ship.lives;
+    unsigned int actions = candidateActions[index % CANDIDATE_COUNT];
+    float value = 0;
+    
+    for (int tick = 0; tick < config->horizon; tick++) {
+        if (tick >= config->commitTicks && (tick - config->commitTicks) % LOOKAHEAD_RANDOM_HOLD_TICKS == 0) {
+            actions = candidateActions[RandomInt(0, CANDIDATE_COUNT - 2)];
+        }
+        
+        ApplyShipActions(state, actions);
+        UpdateGame(state, LOOKAHEAD_TICK_DT);
+        
+        if (state->ship.lives < startLives || state->state != GAME_STATE_PLAYING) {
+            // Dying sooner is worse than dying at the end of the horizon
+            value -= LOOKAHEAD_DEATH_PENALTY * (config->horizon - tick) / config->horizon;
+            break;
+        }
+    }
+    
+    lookahead->values[index] = value + (state->score - startScore);
+    
+    SetEffectsEnabled(savedEffects);
+    SetRandomState(savedRandom);
+}
+
+// Clone slots follow the largest state seen so far, since swarm games carry more asteroid slots
+static bool ReserveClones(Lookahead* lookahead, const GameState* state) {
+    size_t stride = GetGameStateSize(state->maxAsteroids, state->chunkColumns * state->chunkRows);
+    stride = (stride + LOOKAHEAD_CLONE_ALIGNMENT - 1) / LOOKAHEAD_CLONE_ALIGNMENT * LOOKAHEAD_CLONE_ALIGNMENT;
+    if (stride <= lookahead->cloneStride) return true;
+    
+    unsigned char* clones = aligned_alloc(LOOKAHEAD_CLONE_ALIGNMENT, stride * lookahead->config.rollouts);
+    if (!clones) return false;
+    
+    free(lookahead->clones);
+    lookahead->clones = clones;
+    lookahead->cloneStride = stride;
+    return true;
+}
+
+LookaheadResult RunLookahead(Lookahead* lookahead, const GameState* state, uint64_t seed) {
+    LookaheadResult result = {0, 0, 0};
+    if (!lookahead || state->state != GAME_STATE_PLAYING) return result;
+    if (!ReserveClones(lookahead, state)) return result;
+    
+    lookahead->root = state;
+    lookahead->seed = seed;
+    RunJobs(lookahead->jobs, RunRollout, lookahead, lookahead->config.rollouts);
+    
+    // Reduce in rollout order so the sums are identical whatever the scheduling
+    float totals[CANDIDATE_COUNT] = {0};
+    int counts[CANDIDATE_COUNT] = {0};
+    for (int i = 0; i < lookahead->config.rollouts; i++) {
+        totals[i % CANDIDATE_COUNT] += lookahead->values[i];
+        counts[i % CANDIDATE_COUNT]++;
+    }
+    
+    bool found = false;
+    for (int c = 0; c < CANDIDATE_COUNT; c++) {
+        if (counts[c] == 0) continue;
+        float mean = totals[c] / counts[c];
+        if (!found || mean > result.value) {
+            result.actions = candidateActions[c];
+            result.value = mean;
+            found = true;
+        }
+    }
+    
+    result.rollouts = lookahead->config.rollouts;
+    lookahead->root = nullptr;
+    return result;
+}
@@ -0,0 +1,37 @@
+#ifndef LOOKAHEAD_H
+#define LOOKAHEAD_H
+
+#include "game.h"
+#include <stdint.h>
+
+// Monte-Carlo lookahead: each rollout clones the game, holds one candidate
+// action for a few ticks, then plays randomly to the horizon. Every rollout
+// owns its random stream and its result slot, so the chosen action depends
+// only on the state and seed, never on the worker count.
+
+#define LOOKAHEAD_DEFAULT_ROLLOUTS 132
+#define LOOKAHEAD_DEFAULT_HORIZON 90
+#define LOOKAHEAD_DEFAULT_COMMIT_TICKS 12
+
+typedef struct {
+    int rollouts;
+    int horizon;
+    int commitTicks;
+    int workerCount;
+} LookaheadConfig;
+
+typedef struct {
+    unsigned int actions;
+    float value;
+    int rollouts;
+} LookaheadResult;
+
+typedef struct Lookahead Lookahead;
+
+LookaheadConfig GetDefaultLookaheadConfig(void);
+Lookahead* CreateLookahead(const LookaheadConfig* config);
+void DestroyLookahead(Lookahead* lookahead);
+
+LookaheadResult RunLookahead(Lookahead* lookahead, const GameState* state, uint64_t seed);
+
+#endif
@@ -2,63 +2,373 @@
 #include "game.h"
 #include "input.h"
 #include "audio.h"
+#include "hud.h"
+#include "instancing.h"
+#include "particles.h"
+#include "render.h"
+#include "pacing.h"
+#include "ai.h"
+#include "tuning.h"
+#include "scores.h"
+#include "telemetry.h"
+#include "replay.h"
+#include "world.h"
+#include "capture.h"
+#include "scenarios.h"
+#include "utils.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
 #endif
 
-#define SCREEN_WIDTH 1920
-#define SCREEN_HEIGHT 1080
+// Simulation always runs in this logical playfield regardless of window size
+#define LOGICAL_WIDTH 1920
+#define LOGICAL_HEIGHT 1080
 #define TARGET_FPS 60
+#define DEFAULT_RENDER_SCALE 1.0f
+#define ATTRACT_IDLE_DELAY 15.0
+#define DEFAULT_DATA_DIRECTORY "data"
 
 typedef struct {
     GameState* gameState;
     bool shouldClose;
+    float renderScale;
+    bool dynamicResolution;
+    bool attractEnabled;
+    bool swarmLevels;
+    bool openSpace;
+    bool memoryReport;
+    bool lateInput;
+    float frameDelay;
+    const char* tuningPath;
+    const char* tuningExportPath;
+    const char* dataDirectory;
+    const char* telemetryPath;
+    const char* replayPath;
+    const char* capturePath;
+    const char* stressName;
+    const char* stressCountList;
+    int stressTicks;
+    bool stressActive;
+    int stressCounts[SCENARIO_MAX_COUNTS];
+    int stressCountCount;
+    int stressPoint;
+    ScenarioRun stressRun;
+    double launchTime;
+    double windowTime;
+    uint32_t frameCount;
+    GameStateType previousState;
+    bool attractActive;
+    bool attractTimerArmed;
+    double menuIdleSince;
+    int savedHighScore;
+    AIPilot pilot;
 } MainContext;
 
 static MainContext mainCtx = {0};
 
+// Starts an AI-piloted demo after the menu sits idle; any key returns to the menu
+static void UpdateAttractMode(const InputSample* input) {
+    GameState* state = mainCtx.gameState;
+    
+    if (mainCtx.attractActive) {
+        if ((input->pressed & INPUT_ANY_KEY) || state->state == GAME_STATE_GAME_OVER) {
+            state->highScore = mainCtx.savedHighScore;
+            InitGame(state);
+            mainCtx.attractActive = false;
+            mainCtx.attractTimerArmed = false;
+        }
+        return;
+    }
+    
+    if (state->state != GAME_STATE_MENU) {
+        mainCtx.attractTimerArmed = false;
+        return;
+    }
+    
+    if (!mainCtx.attractTimerArmed) {
+        mainCtx.menuIdleSince = GetTime();
+        mainCtx.attractTimerArmed = true;
+        SchedulePacingWakeup(ATTRACT_IDLE_DELAY);
+        return;
+    }
+    
+    if (GetTime() - mainCtx.menuIdleSince >= ATTRACT_IDLE_DELAY) {
+        mainCtx.savedHighScore = state->highScore;
+        CloseAIPilot(&mainCtx.pilot);
+        if (!InitAIPilot(&mainCtx.pilot, &AI_BEHAVIOUR_ATTRACT, AI_DEFAULT_BUDGET_US)) {
+            mainCtx.attractTimerArmed = false;
+            return;
+        }
+        StartNewGame(state);
+        mainCtx.attractActive = true;
+    }
+}
+
+// Records finished games and picks up the best saved score once storage is available
+static void UpdateSavedScores(void) {
+    GameState* state = mainCtx.gameState;
+    
+    UpdateScoreStore();
+    
+    if (state->state == GAME_STATE_GAME_OVER && mainCtx.previousState == GAME_STATE_PLAYING &&
+        !mainCtx.attractActive) {
+        SubmitScore(state->score, state->level, state->playTime, state->seed);
+    }
+    mainCtx.previousState = state->state;
+    
+    int best = GetBestScore();
+    if (best > state->highScore) {
+        state->highScore = best;
+    }
+}
+
+// Time to first frame, from main() to the first presented frame
+static void ReportFirstFrame(void) {
+    double firstFrame = GetMonotonicTime() - mainCtx.launchTime;
+    TraceLog(LOG_INFO, "ASTEROIDS: First frame %.1f ms after launch (window %.1f ms)",
+             firstFrame * 1000.0, mainCtx.windowTime * 1000.0);
+    EmitTelemetry(TELEMETRY_STARTUP, TELEMETRY_STARTUP_WINDOW, 0, 0, (float)mainCtx.windowTime);
+    EmitTelemetry(TELEMETRY_STARTUP, TELEMETRY_STARTUP_FIRST_FRAME, 0, 0, (float)firstFrame);
+}
+
+// Finishes the sweep point once it has enough ticks, then moves to the next
+// count, or closes after the last
+static void UpdateStressSweep(double frameWork) {
+    ScenarioRun* run = &mainCtx.stressRun;
+    AddScenarioFrameTime(run, frameWork);
+    if (!IsScenarioRunDone(run, mainCtx.stressTicks)) return;
+    
+    WriteScenarioSample(stdout, run, true);
+    if (++mainCtx.stressPoint < mainCtx.stressCountCount) {
+        BeginScenarioRun(run, mainCtx.gameState, run->id, mainCtx.stressCounts[mainCtx.stressPoint]);
+    } else {
+        mainCtx.shouldClose = true;
+    }
+}
+
 void UpdateDrawFrame(void) {
-    // Update screen dimensions if window was resized
-    int currentWidth = GetScreenWidth();
-    int currentHeight = GetScreenHeight();
-    if (currentWidth != mainCtx.gameState->screenWidth || currentHeight != mainCtx.gameState->screenHeight) {
-        mainCtx.gameState->screenWidth = currentWidth;
-        mainCtx.gameState->screenHeight = currentHeight;
+    float frameTime = BeginPacedFrame();
+    double frameStart = GetMonotonicTime();
+    
+    SetTelemetryFrame(++mainCtx.frameCount);
+    EmitTelemetry(TELEMETRY_FRAME, mainCtx.gameState->state, 0, 0, frameTime);
+    UpdateTelemetry(GetTime());
+    if (PollTuningReload(GetTime())) {
+        MarkReplayRetuned(mainCtx.gameState);
     }
     
-    ProcessInput(mainCtx.gameState);
+    // Sampled as close to the simulation step as possible
+    InputSample input;
+    SampleInput(&input, IsLateInputEnabled());
+    MarkInputSampled(input.time);
     
-    UpdateGame(mainCtx.gameState, GetFrameTime());
+    if (mainCtx.attractEnabled) {
+        UpdateAttractMode(&input);
+    }
     
-    BeginDrawing();
+    // Stress sweeps step at a fixed tick so every run loads the game the same way
+    if (mainCtx.stressActive) {
+        StepScenarioRun(&mainCtx.stressRun, mainCtx.gameState);
+    } else {
+        unsigned int actions;
+        if (mainCtx.attractActive) {
+            actions = UpdateAIPilot(&mainCtx.pilot, mainCtx.gameState);
+            ApplyShipActions(mainCtx.gameState, actions);
+        } else {
+            actions = ProcessInput(mainCtx.gameState, &input);
+        }
+        
+        UpdateGame(mainCtx.gameState, frameTime);
+        RecordReplayTick(mainCtx.gameState, actions, frameTime);
+    }
+    UpdateSavedScores();
+    
+    // Static screens switch to event waiting before this frame's EndDrawing()
+    UpdateFramePacing(mainCtx.gameState->state);
+    
+    // Re-rasterize cached HUD layers before the frame so only changed values cost draw calls
+    UpdateHudCache(mainCtx.gameState);
+    
+    BeginScaledDrawing();
         ClearBackground(BLACK);
         DrawGame(mainCtx.gameState);
+    EndScaledDrawing();
+    CaptureFrame();
+    
+    BeginDrawing();
+        ClearBackground(BLACK);
+        DrawScaledFrame();
+        MarkFrameWorkDone();
+        double frameWork = GetMonotonicTime() - frameStart;
     EndDrawing();
+    MarkFramePresented();
+    
+    if (mainCtx.frameCount == 1) {
+        ReportFirstFrame();
+    }
+    if (UpdateGameAudio()) {
+        TraceLog(LOG_INFO, "ASTEROIDS: Audio ready; startup took %.1f ms off the frame thread",
+                 GetGameAudioStartupTime() * 1000.0);
+        EmitTelemetry(TELEMETRY_STARTUP, TELEMETRY_STARTUP_AUDIO, 0, 0, (float)GetGameAudioStartupTime());
+    }
+    if (mainCtx.stressActive) {
+        UpdateStressSweep(frameWork);
+    }
+    
+    if (!IsFramePacingIdle()) {
+        UpdateDynamicResolution(frameTime, GetPacingFrameBudget());
+    }
     
     if (WindowShouldClose()) {
         mainCtx.shouldClose = true;
     }
 }
 
-int main(void) {
-    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Asteroids");
-    SetTargetFPS(TARGET_FPS);
+static void ParseArguments(int argc, char** argv) {
+    mainCtx.renderScale = DEFAULT_RENDER_SCALE;
+    mainCtx.dynamicResolution = true;
+    mainCtx.dataDirectory = DEFAULT_DATA_DIRECTORY;
+    mainCtx.stressTicks = SCENARIO_DEFAULT_TICKS;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--render-scale=", 15) == 0) {
+            mainCtx.renderScale = strtof(argv[i] + 15, nullptr);
+        } else if (strcmp(argv[i], "--no-dynamic-resolution") == 0) {
+            mainCtx.dynamicResolution = false;
+        } else if (strcmp(argv[i], "--attract") == 0) {
+            mainCtx.attractEnabled = true;
+        } else if (strcmp(argv[i], "--swarm") == 0) {
+            mainCtx.swarmLevels = true;
+        } else if (strcmp(argv[i], "--open-space") == 0) {
+            mainCtx.openSpace = true;
+        } else if (strncmp(argv[i], "--tuning=", 9) == 0) {
+            mainCtx.tuningPath = argv[i] + 9;
+        } else if (strncmp(argv[i], "--write-tuning=", 15) == 0) {
+            mainCtx.tuningExportPath = argv[i] + 15;
+        } else if (strncmp(argv[i], "--data-dir=", 11) == 0) {
+            mainCtx.dataDirectory = argv[i] + 11;
+        } else if (strncmp(argv[i], "--telemetry=", 12) == 0) {
+            mainCtx.telemetryPath = argv[i] + 12;
+        } else if (strcmp(argv[i], "--memory-report") == 0) {
+            mainCtx.memoryReport = true;
+        } else if (strncmp(argv[i], "--record=", 9) == 0) {
+            mainCtx.replayPath = argv[i] + 9;
+        } else if (strncmp(argv[i], "--stress=", 9) == 0) {
+            mainCtx.stressName = argv[i] + 9;
+        } else if (strncmp(argv[i], "--stress-counts=", 16) == 0) {
+            mainCtx.stressCountList = argv[i] + 16;
+        } else if (strncmp(argv[i], "--stress-ticks=", 15) == 0) {
+            mainCtx.stressTicks = atoi(argv[i] + 15);
+        } else if (strncmp(argv[i], "--capture=", 10) == 0) {
+            mainCtx.capturePath = argv[i] + 10;
+        } else if (strcmp(argv[i], "--late-input") == 0) {
+            mainCtx.lateInput = true;
+            mainCtx.frameDelay = -1.0f;
+        } else if (strncmp(argv[i], "--frame-delay=", 14) == 0) {
+            mainCtx.lateInput = true;
+            mainCtx.frameDelay = strtof(argv[i] + 14, nullptr) / 1000.0f;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    mainCtx.launchTime = GetMonotonicTime();
+    ParseArguments(argc, argv);
+    
+    // Writes the built-in values as a starting point for parameter sweeps
+    if (mainCtx.tuningExportPath) {
+        if (!SaveTuningTable(mainCtx.tuningExportPath, GetDefaultTuning())) {
+            fprintf(stderr, "Failed to write tuning table: %s\n", mainCtx.tuningExportPath);
+            return 1;
+        }
+        return 0;
+    }
     
-    InitAudioDevice();
-    InitGameAudio();
+    // Stress sweeps play swarm-sized games at a fixed render scale
+    int stressScenario = -1;
+    if (mainCtx.stressName) {
+        stressScenario = FindScenario(mainCtx.stressName);
+        if (stressScenario < 0) {
+            fprintf(stderr, "Unknown stress scenario: %s\n", mainCtx.stressName);
+            return 1;
+        }
+        mainCtx.swarmLevels = true;
+        mainCtx.openSpace = false;
+        mainCtx.dynamicResolution = false;
+        if (mainCtx.stressTicks < 1) mainCtx.stressTicks = 1;
+    }
     
-    mainCtx.gameState = CreateGameState(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (mainCtx.tuningPath) {
+        LoadTuningTable(mainCtx.tuningPath);
+    }
+    
+    // Audio opens in the background while the window comes up
+    StartGameAudio();
+    
+    // Late input leaves pacing to the display's refresh so the frame delay can line up with it
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE | (mainCtx.lateInput ? FLAG_VSYNC_HINT : 0));
+    InitWindow(LOGICAL_WIDTH, LOGICAL_HEIGHT, "Asteroids");
+    mainCtx.windowTime = GetMonotonicTime() - mainCtx.launchTime;
+    InitFramePacing(TARGET_FPS);
+    if (mainCtx.lateInput) {
+        EnableLateInput(mainCtx.frameDelay);
+    }
+    InitAsteroidInstancing();
+    InitRenderScaling(LOGICAL_WIDTH, LOGICAL_HEIGHT, mainCtx.renderScale);
+    SetDynamicResolution(mainCtx.dynamicResolution);
+    
+    // The video's frame size is fixed, so the render scale holds still while capturing
+    if (mainCtx.capturePath && StartCapture(mainCtx.capturePath, (int)(1.0f / GetPacingFrameBudget() + 0.5f))) {
+        SetDynamicResolution(false);
+    }
+    
+    InitParticles();
+    
+    if (mainCtx.openSpace) {
+        mainCtx.gameState = CreateWorldGameState(LOGICAL_WIDTH, LOGICAL_HEIGHT,
+                                                 LOGICAL_WIDTH * WORLD_SCREENS_WIDE,
+                                                 LOGICAL_HEIGHT * WORLD_SCREENS_HIGH,
+                                                 MAX_SWARM_ASTEROIDS, 0);
+    } else if (mainCtx.swarmLevels) {
+        mainCtx.gameState = CreateGameStateEx(LOGICAL_WIDTH, LOGICAL_HEIGHT, MAX_SWARM_ASTEROIDS);
+    } else {
+        mainCtx.gameState = CreateGameState(LOGICAL_WIDTH, LOGICAL_HEIGHT);
+    }
     if (!mainCtx.gameState) {
         fprintf(stderr, "Failed to create game state\n");
+        CloseGameAudio();
         CloseWindow();
         return 1;
     }
+    if (mainCtx.openSpace) {
+        mainCtx.gameState->levelSet = LEVEL_SET_OPEN_SPACE;
+    } else if (mainCtx.swarmLevels) {
+        mainCtx.gameState->levelSet = LEVEL_SET_SWARM;
+    }
     
     InitGame(mainCtx.gameState);
+    mainCtx.previousState = mainCtx.gameState->state;
+    if (stressScenario >= 0) {
+        mainCtx.stressCountCount = ParseScenarioCounts(mainCtx.stressCountList, mainCtx.gameState->maxAsteroids,
+                                                       mainCtx.stressCounts);
+        mainCtx.stressActive = mainCtx.stressCountCount > 0;
+    }
+    if (mainCtx.stressActive) {
+        WriteScenarioHeader(stdout, true);
+        BeginScenarioRun(&mainCtx.stressRun, mainCtx.gameState, stressScenario, mainCtx.stressCounts[0]);
+    }
+    OpenScoreStore(mainCtx.dataDirectory);
+    if (mainCtx.telemetryPath) {
+        StartTelemetry(mainCtx.telemetryPath);
+    }
+    if (mainCtx.replayPath) {
+        StartReplayRecording(mainCtx.replayPath);
+    }
     
 #if defined(PLATFORM_WEB)
     emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
@@ -68,10 +378,23 @@ int main(void) {
     }
 #endif
     
+    StopCapture();
+    StopReplayRecording();
+    StopTelemetry();
+    CloseScoreStore();
+    if (mainCtx.memoryReport) {
+        WriteSessionMemoryReport(mainCtx.gameState, stdout);
+        printf("peak memory: %zu bytes\n", GetPeakMemoryUsage());
+    }
     DestroyGameState(mainCtx.gameState);
+    CloseAIPilot(&mainCtx.pilot);
+    UnloadHudCache();
+    CloseRenderScaling();
+    UnloadAsteroidInstancing();
+    CloseParticles();
     CloseGameAudio();
-    CloseAudioDevice();
     CloseWindow();
+    UnloadTuningTable();
     
     return 0;
 }
\ No newline at end of file
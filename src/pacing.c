@@ -0,0 +1,285 @@
+#include "pacing.h"
+#include "raylib.h"
+#include "telemetry.h"
+#include <time.h>
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#endif
+
+#define MIN_PLAY_FPS 30
+#define MAX_PLAY_FPS 240
+#define TIMER_IDLE_FPS 10
+#define MAX_FRAME_TIME 0.1f
+#define UTILIZATION_REPORT_INTERVAL 5.0
+
+// Late input: the automatic frame delay plans for the slowest recent frame
+// plus a margin for the swap, and stands down for a while after a miss
+#define FRAME_DELAY_HISTORY 32
+#define FRAME_DELAY_MARGIN 0.0015
+#define FRAME_DELAY_HOLDOFF 120
+
+typedef enum {
+    PACING_PLAYING,
+    PACING_TIMER_IDLE,
+    PACING_EVENT_WAIT
+} PacingMode;
+
+typedef struct {
+    PacingMode mode;
+    int playFps;
+    double frameStart;
+    double wakeupTime;
+    bool wakeupPending;
+    double reportStart;
+    clock_t reportCpuStart;
+    double workTime;
+    float cpuUtilization;
+    float workUtilization;
+    bool initialized;
+    
+    bool lateInput;
+    float frameDelay;
+    double deadline;
+    double workDone;
+    float workHistory[FRAME_DELAY_HISTORY];
+    int workHistoryNext;
+    int delayHoldoff;
+    
+    double inputTime;
+    float inputLatency;
+    double latencySum;
+    float latencyMax;
+    int latencyCount;
+    int missedFrames;
+} FramePacing;
+
+static FramePacing pacing = {0};
+
+static int PickPlayFps(int fallbackFps) {
+#if defined(PLATFORM_WEB)
+    (void)fallbackFps;
+    return 0;
+#else
+    int refresh = GetMonitorRefreshRate(GetCurrentMonitor());
+    if (refresh < MIN_PLAY_FPS || refresh > MAX_PLAY_FPS) {
+        return fallbackFps;
+    }
+    return refresh;
+#endif
+}
+
+static void ApplyPacingMode(PacingMode mode) {
+    if (pacing.initialized && mode == pacing.mode) return;
+    
+#if defined(PLATFORM_WEB)
+    // The browser drives the loop, so idle states only lower the callback rate
+    if (mode == PACING_PLAYING) {
+        emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+    } else {
+        emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, 1000 / TIMER_IDLE_FPS);
+    }
+#else
+    switch (mode) {
+        case PACING_PLAYING:
+            // Late input paces play itself, from the start of the next frame
+            DisableEventWaiting();
+            SetTargetFPS(pacing.lateInput ? 0 : pacing.playFps);
+            break;
+        case PACING_TIMER_IDLE:
+            DisableEventWaiting();
+            SetTargetFPS(TIMER_IDLE_FPS);
+            break;
+        case PACING_EVENT_WAIT:
+            // EndDrawing() now blocks in glfwWaitEvents() until input arrives
+            EnableEventWaiting();
+            break;
+    }
+#endif
+    
+    // Play resumes on a fresh schedule rather than one left over from before the menu
+    pacing.deadline = 0;
+    pacing.mode = mode;
+    pacing.initialized = true;
+}
+
+void InitFramePacing(int fallbackFps) {
+    pacing.playFps = PickPlayFps(fallbackFps);
+    pacing.reportStart = GetTime();
+    pacing.reportCpuStart = clock();
+    pacing.frameStart = pacing.reportStart;
+    
+    TraceLog(LOG_INFO, "ASTEROIDS: Gameplay frame rate %d FPS", pacing.playFps);
+}
+
+void EnableLateInput(float frameDelay) {
+#if defined(PLATFORM_WEB)
+    // The browser composites after the frame callback returns, so there is no swap to wait for
+    (void)frameDelay;
+    TraceLog(LOG_WARNING, "ASTEROIDS: Late input is not available in the browser");
+#else
+    pacing.lateInput = true;
+    pacing.frameDelay = frameDelay;
+    if (pacing.initialized) {
+        pacing.initialized = false;
+        ApplyPacingMode(pacing.mode);
+    }
+    
+    if (frameDelay < 0) {
+        TraceLog(LOG_INFO, "ASTEROIDS: Late input, automatic frame delay");
+    } else {
+        TraceLog(LOG_INFO, "ASTEROIDS: Late input, frame delay %.1f ms", frameDelay * 1000.0f);
+    }
+#endif
+}
+
+bool IsLateInputEnabled(void) {
+    return pacing.lateInput;
+}
+
+static float GetPredictedWork(void) {
+    float longest = 0.0f;
+    for (int i = 0; i < FRAME_DELAY_HISTORY; i++) {
+        if (pacing.workHistory[i] > longest) longest = pacing.workHistory[i];
+    }
+    return longest;
+}
+
+// Sleeps until the latest moment the frame's work can start and still be
+// presented by the deadline. A fixed delay counts from the previous present.
+static void WaitForFrameDelay(void) {
+    if (pacing.delayHoldoff > 0) {
+        pacing.delayHoldoff--;
+        return;
+    }
+    
+    double budget = GetPacingFrameBudget();
+    double wake;
+    if (pacing.frameDelay < 0) {
+        wake = pacing.deadline - GetPredictedWork() - FRAME_DELAY_MARGIN;
+    } else {
+        wake = pacing.deadline - budget + pacing.frameDelay;
+    }
+    
+    double wait = wake - GetTime();
+    if (wait > budget) wait = budget;
+    if (wait > 0) WaitTime(wait);
+}
+
+// Returns the frame time to simulate with, clamped so that waking from an
+// event wait does not hand the simulation a multi-second step
+float BeginPacedFrame(void) {
+    if (pacing.lateInput && pacing.mode == PACING_PLAYING) {
+        WaitForFrameDelay();
+    }
+    pacing.frameStart = GetTime();
+    
+    float frameTime = GetFrameTime();
+    if (frameTime > MAX_FRAME_TIME) {
+        frameTime = MAX_FRAME_TIME;
+    }
+    return frameTime;
+}
+
+void UpdateFramePacing(GameStateType state) {
+    if (pacing.wakeupPending && GetTime() >= pacing.wakeupTime) {
+        pacing.wakeupPending = false;
+    }
+    
+    if (state == GAME_STATE_PLAYING) {
+        ApplyPacingMode(PACING_PLAYING);
+    } else if (pacing.wakeupPending) {
+        ApplyPacingMode(PACING_TIMER_IDLE);
+    } else {
+        ApplyPacingMode(PACING_EVENT_WAIT);
+    }
+}
+
+void MarkFrameWorkDone(void) {
+    double now = GetTime();
+    pacing.workDone = now;
+    pacing.workTime += now - pacing.frameStart;
+    pacing.workHistory[pacing.workHistoryNext] = (float)(now - pacing.frameStart);
+    pacing.workHistoryNext = (pacing.workHistoryNext + 1) % FRAME_DELAY_HISTORY;
+    
+    double elapsed = now - pacing.reportStart;
+    if (elapsed < UTILIZATION_REPORT_INTERVAL) return;
+    
+    double cpuSeconds = (double)(clock() - pacing.reportCpuStart) / CLOCKS_PER_SEC;
+    pacing.cpuUtilization = (float)(cpuSeconds / elapsed);
+    pacing.workUtilization = (float)(pacing.workTime / elapsed);
+    
+    TraceLog(LOG_INFO, "ASTEROIDS: CPU %.1f%% (frame work %.1f%%)",
+             pacing.cpuUtilization * 100.0f, pacing.workUtilization * 100.0f);
+    if (pacing.latencyCount > 0) {
+        TraceLog(LOG_INFO, "ASTEROIDS: Input to present %.2f ms average, %.2f ms worst, %d missed frames",
+                 pacing.latencySum / pacing.latencyCount * 1000.0, pacing.latencyMax * 1000.0f,
+                 pacing.missedFrames);
+    }
+    
+    pacing.reportStart = now;
+    pacing.reportCpuStart = clock();
+    pacing.workTime = 0;
+    pacing.latencySum = 0;
+    pacing.latencyMax = 0;
+    pacing.latencyCount = 0;
+    pacing.missedFrames = 0;
+}
+
+void MarkInputSampled(double time) {
+    pacing.inputTime = time;
+}
+
+// Called once EndDrawing() returns. With late input the swap waits for the
+// display, so that is the present. Otherwise EndDrawing() also sleeps off
+// raylib's frame cap after swapping, and the submit time stands in for it.
+void MarkFramePresented(void) {
+    if (pacing.mode != PACING_PLAYING) return;
+    
+    double present = pacing.lateInput ? GetTime() : pacing.workDone;
+    pacing.inputLatency = (float)(present - pacing.inputTime);
+    pacing.latencySum += pacing.inputLatency;
+    pacing.latencyCount++;
+    if (pacing.inputLatency > pacing.latencyMax) {
+        pacing.latencyMax = pacing.inputLatency;
+    }
+    EmitTelemetry(TELEMETRY_INPUT_LATENCY, pacing.lateInput, 0, 0, pacing.inputLatency);
+    
+    if (!pacing.lateInput) return;
+    
+    // The next deadline is a frame on from this one, or from the present if
+    // the display (or a slow frame) held it later; a frame presented half a
+    // budget or more late missed its refresh
+    double budget = GetPacingFrameBudget();
+    if (present > pacing.deadline + budget * 0.5 && pacing.deadline > 0) {
+        pacing.missedFrames++;
+        pacing.delayHoldoff = FRAME_DELAY_HOLDOFF;
+    }
+    pacing.deadline = (present > pacing.deadline ? present : pacing.deadline) + budget;
+}
+
+// Static states normally sleep until input; a pending wakeup keeps a slow
+// polling loop alive so the timer can fire without any input
+void SchedulePacingWakeup(double delaySeconds) {
+    double wakeup = GetTime() + delaySeconds;
+    if (!pacing.wakeupPending || wakeup < pacing.wakeupTime) {
+        pacing.wakeupTime = wakeup;
+    }
+    pacing.wakeupPending = true;
+}
+
+bool IsFramePacingIdle(void) {
+    return pacing.mode != PACING_PLAYING;
+}
+
+float GetPacingFrameBudget(void) {
+    return (pacing.playFps > 0) ? 1.0f / pacing.playFps : 1.0f / 60.0f;
+}
+
+float GetCpuUtilization(void) {
+    return pacing.cpuUtilization;
+}
+
+float GetInputLatency(void) {
+    return pacing.inputLatency;
+}
\ No newline at end of file
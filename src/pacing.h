@@ -0,0 +1,32 @@
+#ifndef PACING_H
+#define PACING_H
+
+#include "game.h"
+#include <stdbool.h>
+
+void InitFramePacing(int fallbackFps);
+
+// Late input: play is paced from the start of each frame instead of inside
+// EndDrawing(), so input is polled after the wait rather than before it.
+// frameDelay is how long after a present to start the next frame; negative
+// picks it automatically from recent frame times.
+void EnableLateInput(float frameDelay);
+bool IsLateInputEnabled(void);
+
+float BeginPacedFrame(void);
+void UpdateFramePacing(GameStateType state);
+void MarkFrameWorkDone(void);
+
+// Input-to-present latency while playing, reported with the CPU figures and
+// emitted to telemetry every frame
+void MarkInputSampled(double time);
+void MarkFramePresented(void);
+float GetInputLatency(void);
+
+void SchedulePacingWakeup(double delaySeconds);
+
+bool IsFramePacingIdle(void);
+float GetPacingFrameBudget(void);
+float GetCpuUtilization(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "particles.h"
+#include "utils.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include <string.h>
+
+// The web build gets a smaller pool; emission is thinned before it ever overflows
+#if defined(PLATFORM_WEB)
+    #define PARTICLE_CAPACITY 8192
+#else
+    #define PARTICLE_CAPACITY 65536
+#endif
+
+#define PARTICLE_LANE_WIDTH 4
+#define PARTICLE_DRAG 0.985f
+#define PARTICLE_STREAK_TIME 0.03f
+#define EXPLOSION_SPEED_MIN 40.0f
+#define EXPLOSION_SPEED_MAX 220.0f
+#define EXPLOSION_LIFETIME_MIN 0.4f
+#define EXPLOSION_LIFETIME_MAX 1.1f
+#define THRUST_PARTICLES_PER_EMIT 3
+#define THRUST_SPEED 180.0f
+#define THRUST_SPREAD_DEG 18.0f
+#define THRUST_LIFETIME 0.35f
+#define THRUST_OFFSET 10.0f
+
+typedef float ParticleLane __attribute__((vector_size(PARTICLE_LANE_WIDTH * sizeof(float))));
+
+// Structure-of-arrays pool; live particles are always packed into [0, count)
+typedef struct {
+    alignas(16) float x[PARTICLE_CAPACITY];
+    alignas(16) float y[PARTICLE_CAPACITY];
+    alignas(16) float vx[PARTICLE_CAPACITY];
+    alignas(16) float vy[PARTICLE_CAPACITY];
+    alignas(16) float life[PARTICLE_CAPACITY];
+    alignas(16) float invLifetime[PARTICLE_CAPACITY];
+    Color color[PARTICLE_CAPACITY];
+    int count;
+    int dropped;
+    uint32_t seed;
+    bool ready;
+} ParticlePool;
+
+static ParticlePool pool = {0};
+
+// Particles are cosmetic, so they use their own generator and never disturb gameplay randomness
+static float ParticleRandom(float min, float max) {
+    pool.seed ^= pool.seed << 13;
+    pool.seed ^= pool.seed >> 17;
+    pool.seed ^= pool.seed << 5;
+    return min + (pool.seed >> 8) * (1.0f / 16777216.0f) * (max - min);
+}
+
+static void SpawnParticle(Vector2 position, Vector2 velocity, float lifetime, Color color) {
+    if (pool.count >= PARTICLE_CAPACITY) {
+        pool.dropped++;
+        return;
+    }
+    
+    int i = pool.count++;
+    pool.x[i] = position.x;
+    pool.y[i] = position.y;
+    pool.vx[i] = velocity.x;
+    pool.vy[i] = velocity.y;
+    pool.life[i] = lifetime;
+    pool.invLifetime[i] = 1.0f / lifetime;
+    pool.color[i] = color;
+}
+
+// Above three quarters of capacity only every other particle is emitted
+static int ThrottleEmission(int count) {
+    if (pool.count > PARTICLE_CAPACITY / 4 * 3) {
+        return (count + 1) / 2;
+    }
+    return count;
+}
+
+void InitParticles(void) {
+    pool.count = 0;
+    pool.dropped = 0;
+    pool.seed = 0x9E3779B9u;
+    pool.ready = true;
+}
+
+void CloseParticles(void) {
+    pool.ready = false;
+    pool.count = 0;
+}
+
+void ClearParticles(void) {
+    if (!AreEffectsEnabled()) return;
+    pool.count = 0;
+}
+
+void UpdateParticles(float deltaTime) {
+    if (!pool.ready || pool.count == 0 || !AreEffectsEnabled()) return;
+    
+    ParticleLane dt = {deltaTime, deltaTime, deltaTime, deltaTime};
+    ParticleLane drag = {PARTICLE_DRAG, PARTICLE_DRAG, PARTICLE_DRAG, PARTICLE_DRAG};
+    
+    // Lanes past count hold stale data; updating them is harmless and keeps the loop branch-free
+    int lanes = (pool.count + PARTICLE_LANE_WIDTH - 1) / PARTICLE_LANE_WIDTH;
+    ParticleLane* x = (ParticleLane*)pool.x;
+    ParticleLane* y = (ParticleLane*)pool.y;
+    ParticleLane* vx = (ParticleLane*)pool.vx;
+    ParticleLane* vy = (ParticleLane*)pool.vy;
+    ParticleLane* life = (ParticleLane*)pool.life;
+    
+    for (int i = 0; i < lanes; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        vx[i] *= drag;
+        vy[i] *= drag;
+        life[i] -= dt;
+    }
+    
+    // Swap-remove expired particles to keep the live range packed
+    int i = 0;
+    while (i < pool.count) {
+        if (pool.life[i] > 0) {
+            i++;
+            continue;
+        }
+        
+        int last = --pool.count;
+        pool.x[i] = pool.x[last];
+        pool.y[i] = pool.y[last];
+        pool.vx[i] = pool.vx[last];
+        pool.vy[i] = pool.vy[last];
+        pool.life[i] = pool.life[last];
+        pool.invLifetime[i] = pool.invLifetime[last];
+        pool.color[i] = pool.color[last];
+    }
+}
+
+void DrawParticles(void) {
+    if (!pool.ready || pool.count == 0) return;
+    
+    // One immediate-mode line batch for the whole pool
+    rlBegin(RL_LINES);
+    for (int i = 0; i < pool.count; i++) {
+        Color c = pool.color[i];
+        float fade = pool.life[i] * pool.invLifetime[i];
+        rlColor4ub(c.r, c.g, c.b, (unsigned char)(c.a * fade));
+        rlVertex2f(pool.x[i], pool.y[i]);
+        rlVertex2f(pool.x[i] - pool.vx[i] * PARTICLE_STREAK_TIME, pool.y[i] - pool.vy[i] * PARTICLE_STREAK_TIME);
+    }
+    rlEnd();
+}
+
+void EmitExplosionParticles(Vector2 position, Vector2 velocity, int count) {
+    if (!pool.ready || !AreEffectsEnabled()) return;
+    
+    count = ThrottleEmission(count);
+    for (int i = 0; i < count; i++) {
+        float angle = ParticleRandom(0, 2 * PI);
+        float speed = ParticleRandom(EXPLOSION_SPEED_MIN, EXPLOSION_SPEED_MAX);
+        Vector2 v = {
+            velocity.x + cosf(angle) * speed,
+            velocity.y + sinf(angle) * speed
+        };
+        SpawnParticle(position, v, ParticleRandom(EXPLOSION_LIFETIME_MIN, EXPLOSION_LIFETIME_MAX), WHITE);
+    }
+}
+
+void EmitThrustParticles(Vector2 position, float rotation, Vector2 velocity) {
+    if (!pool.ready || !AreEffectsEnabled()) return;
+    
+    // Exhaust leaves from the back of the ship, opposite the nose direction
+    float exhaust = (rotation + 90) * DEG2RAD;
+    Vector2 nozzle = {
+        position.x + cosf(exhaust) * THRUST_OFFSET,
+        position.y + sinf(exhaust) * THRUST_OFFSET
+    };
+    
+    int count = ThrottleEmission(THRUST_PARTICLES_PER_EMIT);
+    for (int i = 0; i < count; i++) {
+        float angle = exhaust + ParticleRandom(-THRUST_SPREAD_DEG, THRUST_SPREAD_DEG) * DEG2RAD;
+        float speed = ParticleRandom(0.5f, 1.0f) * THRUST_SPEED;
+        Vector2 v = {
+            velocity.x + cosf(angle) * speed,
+            velocity.y + sinf(angle) * speed
+        };
+        SpawnParticle(nozzle, v, ParticleRandom(0.5f, 1.0f) * THRUST_LIFETIME, ORANGE);
+    }
+}
+
+int GetParticleCount(void) {
+    return pool.count;
+}
+
+int GetDroppedParticleCount(void) {
+    return pool.dropped;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+
+void InitParticles(void);
+void CloseParticles(void);
+void ClearParticles(void);
+
+void UpdateParticles(float deltaTime);
+void DrawParticles(void);
+
+void EmitExplosionParticles(Vector2 position, Vector2 velocity, int count);
+void EmitThrustParticles(Vector2 position, float rotation, Vector2 velocity);
+
+int GetParticleCount(void);
+int GetDroppedParticleCount(void);
+
+#endif
\ No newline at end of file
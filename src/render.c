@@ -0,0 +1,160 @@
+#include "render.h"
+#include "raylib.h"
+
+#define MIN_RENDER_SCALE 0.5f
+#define MAX_RENDER_SCALE 2.0f
+#define RENDER_SCALE_DROP_STEP 0.1f
+#define RENDER_SCALE_RAISE_STEP 0.05f
+#define FRAME_SAMPLE_WINDOW 30
+#define OVER_BUDGET_RATIO 1.15f
+#define UNDER_BUDGET_RATIO 1.03f
+// Raising the scale needs several calm windows in a row to avoid oscillating
+#define STABLE_WINDOWS_TO_RAISE 4
+
+typedef struct {
+    RenderTexture2D target;
+    int logicalWidth;
+    int logicalHeight;
+    float scale;
+    float configuredScale;
+    bool dynamic;
+    float frameTimeSum;
+    int frameSamples;
+    int stableWindows;
+} RenderScaler;
+
+static RenderScaler scaler = {0};
+
+static float ClampScale(float scale, float max) {
+    if (scale < MIN_RENDER_SCALE) return MIN_RENDER_SCALE;
+    if (scale > max) return max;
+    return scale;
+}
+
+static void ApplyRenderScale(float scale) {
+    int width = (int)(scaler.logicalWidth * scale + 0.5f);
+    int height = (int)(scaler.logicalHeight * scale + 0.5f);
+    
+    if (scaler.target.id != 0) {
+        if (scaler.target.texture.width == width && scaler.target.texture.height == height) {
+            scaler.scale = scale;
+            return;
+        }
+        UnloadRenderTexture(scaler.target);
+    }
+    
+    scaler.target = LoadRenderTexture(width, height);
+    SetTextureFilter(scaler.target.texture, TEXTURE_FILTER_BILINEAR);
+    scaler.scale = scale;
+    
+    TraceLog(LOG_INFO, "ASTEROIDS: Render scale %.2f (%dx%d)", scale, width, height);
+}
+
+void InitRenderScaling(int logicalWidth, int logicalHeight, float renderScale) {
+    scaler.logicalWidth = logicalWidth;
+    scaler.logicalHeight = logicalHeight;
+    scaler.configuredScale = ClampScale(renderScale, MAX_RENDER_SCALE);
+    scaler.dynamic = true;
+    ApplyRenderScale(scaler.configuredScale);
+}
+
+void CloseRenderScaling(void) {
+    if (scaler.target.id != 0) {
+        UnloadRenderTexture(scaler.target);
+    }
+    scaler = (RenderScaler){0};
+}
+
+void BeginScaledDrawing(void) {
+    Camera2D camera = {
+        .offset = {0, 0},
+        .target = {0, 0},
+        .rotation = 0,
+        .zoom = scaler.scale
+    };
+    
+    BeginTextureMode(scaler.target);
+    BeginMode2D(camera);
+}
+
+void EndScaledDrawing(void) {
+    EndMode2D();
+    EndTextureMode();
+}
+
+// Upscales the offscreen frame to the window, letterboxed to the logical aspect ratio
+void DrawScaledFrame(void) {
+    float windowWidth = (float)GetScreenWidth();
+    float windowHeight = (float)GetScreenHeight();
+    float fit = windowWidth / scaler.logicalWidth;
+    if (windowHeight / scaler.logicalHeight < fit) {
+        fit = windowHeight / scaler.logicalHeight;
+    }
+    
+    Rectangle source = {
+        0, 0,
+        (float)scaler.target.texture.width,
+        -(float)scaler.target.texture.height
+    };
+    Rectangle dest = {
+        (windowWidth - scaler.logicalWidth * fit) / 2,
+        (windowHeight - scaler.logicalHeight * fit) / 2,
+        scaler.logicalWidth * fit,
+        scaler.logicalHeight * fit
+    };
+    
+    DrawTexturePro(scaler.target.texture, source, dest, (Vector2){0, 0}, 0, WHITE);
+}
+
+// The offscreen frame's framebuffer object, for reading the frame back
+unsigned int GetScaledFramebuffer(int* width, int* height) {
+    *width = scaler.target.texture.width;
+    *height = scaler.target.texture.height;
+    return scaler.target.id;
+}
+
+void SetRenderScale(float scale) {
+    scaler.configuredScale = ClampScale(scale, MAX_RENDER_SCALE);
+    scaler.stableWindows = 0;
+    ApplyRenderScale(scaler.configuredScale);
+}
+
+float GetRenderScale(void) {
+    return scaler.scale;
+}
+
+void SetDynamicResolution(bool enabled) {
+    scaler.dynamic = enabled;
+    if (!enabled && scaler.scale != scaler.configuredScale) {
+        ApplyRenderScale(scaler.configuredScale);
+    }
+}
+
+// Averages frame time over a short window, dropping quickly when over budget
+// and climbing back slowly towards the configured scale when there is headroom
+void UpdateDynamicResolution(float frameTime, float frameBudget) {
+    if (!scaler.dynamic) return;
+    
+    scaler.frameTimeSum += frameTime;
+    scaler.frameSamples++;
+    if (scaler.frameSamples < FRAME_SAMPLE_WINDOW) return;
+    
+    float average = scaler.frameTimeSum / scaler.frameSamples;
+    scaler.frameTimeSum = 0;
+    scaler.frameSamples = 0;
+    
+    if (average > frameBudget * OVER_BUDGET_RATIO) {
+        scaler.stableWindows = 0;
+        float scale = ClampScale(scaler.scale - RENDER_SCALE_DROP_STEP, scaler.configuredScale);
+        if (scale != scaler.scale) {
+            ApplyRenderScale(scale);
+        }
+    } else if (average < frameBudget * UNDER_BUDGET_RATIO && scaler.scale < scaler.configuredScale) {
+        if (++scaler.stableWindows >= STABLE_WINDOWS_TO_RAISE) {
+            scaler.stableWindows = 0;
+            ApplyRenderScale(ClampScale(scaler.scale + RENDER_SCALE_RAISE_STEP, scaler.configuredScale));
+        }
+    } else {
+        scaler.stableWindows = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdbool.h>
+
+void InitRenderScaling(int logicalWidth, int logicalHeight, float renderScale);
+void CloseRenderScaling(void);
+
+void BeginScaledDrawing(void);
+void EndScaledDrawing(void);
+void DrawScaledFrame(void);
+unsigned int GetScaledFramebuffer(int* width, int* height);
+
+void SetRenderScale(float scale);
+float GetRenderScale(void);
+void SetDynamicResolution(bool enabled);
+void UpdateDynamicResolution(float frameTime, float frameBudget);
+
+#endif
\ No newline at end of file
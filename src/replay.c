@@ -0,0 +1,180 @@
+#include "replay.h"
+#include "utils.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_PATH_SIZE 512
+
+typedef struct {
+    bool active;
+    char path[REPLAY_PATH_SIZE];
+    FILE* file;
+    uint64_t seed;
+    uint32_t lastTick;
+    uint32_t retunedTick;
+    StateHasher hasher;
+} ReplayRecorder;
+
+static ReplayRecorder recorder = { 0 };
+
+bool StartReplayRecording(const char* path) {
+    if (strlen(path) >= sizeof(recorder.path)) return false;
+    
+    StopReplayRecording();
+    strcpy(recorder.path, path);
+    recorder.active = true;
+    return true;
+}
+
+void StopReplayRecording(void) {
+    if (recorder.file) {
+        fclose(recorder.file);
+        recorder.file = nullptr;
+    }
+    FreeStateHasher(&recorder.hasher);
+    recorder.active = false;
+}
+
+// The first tick of a game rewrites the file and rehashes every slot, as
+// StepReplay's caller does when it replays the game
+static bool BeginRecordedGame(const GameState* state) {
+    if (recorder.file) fclose(recorder.file);
+    recorder.file = fopen(recorder.path, "wb");
+    if (!recorder.file) {
+        fprintf(stderr, "Failed to open replay file: %s\n", recorder.path);
+        recorder.active = false;
+        return false;
+    }
+    
+    if (recorder.hasher.maxAsteroids != state->maxAsteroids) {
+        FreeStateHasher(&recorder.hasher);
+        if (!InitStateHasher(&recorder.hasher, state->maxAsteroids)) {
+            StopReplayRecording();
+            return false;
+        }
+    }
+    ResetStateHasher(&recorder.hasher, state);
+    
+    ReplayHeader header = {
+        .magic = REPLAY_MAGIC,
+        .version = REPLAY_VERSION,
+        .seed = state->seed,
+        .levelSet = state->levelSet,
+        .maxAsteroids = state->maxAsteroids,
+        .screenWidth = state->screenWidth,
+        .screenHeight = state->screenHeight,
+        .worldWidth = state->worldWidth,
+        .worldHeight = state->worldHeight,
+        .tuning = *tuning,
+        .score = REPLAY_SCORE_UNFINISHED
+    };
+    fwrite(&header, sizeof(header), 1, recorder.file);
+    recorder.seed = state->seed;
+    recorder.retunedTick = 0;
+    return true;
+}
+
+// Called once per frame after UpdateGame; frames where the game did not tick
+// (menus, pause, game over) record nothing
+void RecordReplayTick(const GameState* state, unsigned int actions, float deltaTime) {
+    if (!recorder.active || state->tick == recorder.lastTick) return;
+    recorder.lastTick = state->tick;
+    
+    if (state->tick == 1 || state->seed != recorder.seed || !recorder.file) {
+        if (state->tick != 1 || !BeginRecordedGame(state)) return;
+    } else {
+        UpdateStateHasher(&recorder.hasher, state);
+    }
+    
+    ReplayTick record = {
+        .tick = state->tick,
+        .actions = actions,
+        .deltaTime = deltaTime,
+        .digest = recorder.hasher.digest
+    };
+    fwrite(&record, sizeof(record), 1, recorder.file);
+    
+    if (state->state == GAME_STATE_GAME_OVER) {
+        int32_t score = state->score;
+        fseek(recorder.file, offsetof(ReplayHeader, score), SEEK_SET);
+        fwrite(&score, sizeof(score), 1, recorder.file);
+        fseek(recorder.file, 0, SEEK_END);
+    }
+    if (state->state != GAME_STATE_PLAYING) {
+        fflush(recorder.file);
+    }
+}
+
+// A reloaded table applies from the next tick. The game cannot be split into
+// a new recording there, since recordings replay from their first tick.
+void MarkReplayRetuned(const GameState* state) {
+    if (!recorder.file || recorder.retunedTick != 0 || state->seed != recorder.seed) return;
+    if (state->state != GAME_STATE_PLAYING && state->state != GAME_STATE_PAUSED) return;
+    
+    recorder.retunedTick = state->tick + 1;
+    fseek(recorder.file, offsetof(ReplayHeader, retunedTick), SEEK_SET);
+    fwrite(&recorder.retunedTick, sizeof(recorder.retunedTick), 1, recorder.file);
+    fseek(recorder.file, 0, SEEK_END);
+}
+
+bool LoadReplayHeader(const char* path, ReplayHeader* header) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    
+    bool read = fread(header, sizeof(*header), 1, file) == 1;
+    fclose(file);
+    return read && header->magic == REPLAY_MAGIC && header->version == REPLAY_VERSION;
+}
+
+bool LoadReplay(const char* path, Replay* replay) {
+    memset(replay, 0, sizeof(*replay));
+    
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    
+    if (fread(&replay->header, sizeof(replay->header), 1, file) != 1 ||
+        replay->header.magic != REPLAY_MAGIC || replay->header.version != REPLAY_VERSION) {
+        fclose(file);
+        return false;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file) - (long)sizeof(ReplayHeader);
+    fseek(file, sizeof(ReplayHeader), SEEK_SET);
+    
+    // A torn final record from an interrupted game is dropped
+    int capacity = (int)(size / (long)sizeof(ReplayTick));
+    replay->ticks = malloc((capacity > 0 ? capacity : 1) * sizeof(ReplayTick));
+    if (!replay->ticks) {
+        fclose(file);
+        return false;
+    }
+    replay->tickCount = (int)fread(replay->ticks, sizeof(ReplayTick), capacity, file);
+    fclose(file);
+    return true;
+}
+
+void UnloadReplay(Replay* replay) {
+    free(replay->ticks);
+    memset(replay, 0, sizeof(*replay));
+}
+
+GameState* CreateReplayGameState(const Replay* replay) {
+    const ReplayHeader* header = &replay->header;
+    GameState* state = CreateWorldGameState(header->screenWidth, header->screenHeight,
+                                            header->worldWidth, header->worldHeight, header->maxAsteroids, 0);
+    if (!state) return nullptr;
+    
+    state->levelSet = header->levelSet;
+    InitGame(state);
+    SetRandomState(header->seed);
+    StartNewGame(state);
+    return state;
+}
+
+void StepReplay(GameState* state, const ReplayTick* tick) {
+    ApplyShipActions(state, tick->actions);
+    UpdateGame(state, tick->deltaTime);
+}
@@ -0,0 +1,79 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game.h"
+#include "statehash.h"
+#include "tuning.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Game recordings: everything needed to play a game again from its seed,
+// plus the state digest after every tick so a replay, another build or a
+// lockstep peer can be checked against it tick by tick.
+//
+// File layout: a ReplayHeader, then one ReplayTick per simulated tick in
+// order. The recorder rewrites the file whenever a new game starts, so it
+// always holds the latest game. When the game ends its final score is
+// written back into the header, which is what a verifier checks it against.
+//
+// The header carries the tuning table the game started under, and a game
+// must be replayed under it. The table is process-wide, so workers that
+// replay at the same time must share one. A table reloaded mid-game cannot be
+// replayed from the seed, so the recorder writes the first tick played under
+// it into the header and the game counts as unverifiable from there.
+
+#define REPLAY_MAGIC 0x4C505241u  // "ARPL"
+#define REPLAY_VERSION 6
+
+// Score of a recording whose game has not ended
+#define REPLAY_SCORE_UNFINISHED -1
+
+// The frame loop never simulates a longer tick than this (MAX_FRAME_TIME in pacing.c)
+#define REPLAY_MAX_TICK_TIME 0.1f
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;
+    int32_t levelSet;
+    int32_t maxAsteroids;
+    float screenWidth;
+    float screenHeight;
+    float worldWidth;
+    float worldHeight;
+    TuningTable tuning;
+    int32_t score;
+    // First tick under a reloaded tuning table, or 0
+    uint32_t retunedTick;
+} ReplayHeader;
+
+// Actions applied before the tick's update; the digest is taken after it
+typedef struct {
+    uint32_t tick;
+    uint32_t actions;
+    float deltaTime;
+    uint32_t reserved;
+    StateDigest digest;
+} ReplayTick;
+
+typedef struct {
+    ReplayHeader header;
+    ReplayTick* ticks;
+    int tickCount;
+} Replay;
+
+bool StartReplayRecording(const char* path);
+void StopReplayRecording(void);
+void RecordReplayTick(const GameState* state, unsigned int actions, float deltaTime);
+void MarkReplayRetuned(const GameState* state);
+
+bool LoadReplayHeader(const char* path, ReplayHeader* header);
+bool LoadReplay(const char* path, Replay* replay);
+void UnloadReplay(Replay* replay);
+
+// Creates a state shaped like the recorded one and starts its game from the
+// seed; set the recorded tuning table first
+GameState* CreateReplayGameState(const Replay* replay);
+void StepReplay(GameState* state, const ReplayTick* tick);
+
+#endif
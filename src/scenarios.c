@@ -0,0 +1,216 @@
+#include "scenarios.h"
+#include "utils.h"
+#include "world.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENARIO_FIRST_COUNT 64
+#define SCENARIO_WAVE_INTERVAL 120
+#define SCENARIO_STORM_INTERVAL 60
+#define SCENARIO_SAFE_RADIUS 150.0f
+
+typedef struct {
+    const char* name;
+    const char* description;
+} ScenarioInfo;
+
+static const ScenarioInfo scenarioInfo[SCENARIO_COUNT] = {
+    [SCENARIO_WAVES] = { "waves", "the field refilled to the count in a burst every two seconds" },
+    [SCENARIO_BULLET_HELL] = { "bullet-hell", "both UFOs firing every tick into a field of the count" },
+    [SCENARIO_SPLIT_STORM] = { "split-storm", "every asteroid of the largest size split at once each second" },
+};
+
+int FindScenario(const char* name) {
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        if (strcmp(name, scenarioInfo[i].name) == 0) return i;
+    }
+    return -1;
+}
+
+const char* GetScenarioName(ScenarioId id) {
+    return (id >= 0 && id < SCENARIO_COUNT) ? scenarioInfo[id].name : "unknown";
+}
+
+const char* GetScenarioDescription(ScenarioId id) {
+    return (id >= 0 && id < SCENARIO_COUNT) ? scenarioInfo[id].description : "";
+}
+
+int ParseScenarioCounts(const char* list, int maxCount, int counts[SCENARIO_MAX_COUNTS]) {
+    int count = 0;
+    if (!list) {
+        for (int value = SCENARIO_FIRST_COUNT; value <= maxCount && count < SCENARIO_MAX_COUNTS; value *= 2) {
+            counts[count++] = value;
+        }
+        return count;
+    }
+    
+    while (*list && count < SCENARIO_MAX_COUNTS) {
+        char* end;
+        long value = strtol(list, &end, 10);
+        if (end == list) break;
+        if (value >= 1) counts[count++] = value < maxCount ? (int)value : maxCount;
+        list = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+// Spread over the playfield clear of the ship; slots past capacity are dropped
+static void FillAsteroids(GameState* state, int count, AsteroidSize size) {
+    if (count <= 0) return;
+    SpawnIndex index;
+    BuildSpawnIndex(&index, state->worldWidth, state->worldHeight, count, state->ship.position, SCENARIO_SAFE_RADIUS);
+    SpawnAsteroids(state, &index, count, size);
+    RebuildWorldChunks(state);
+}
+
+// Splits the largest size present only, so this round's children wait for the next
+static void SplitLargestAsteroids(GameState* state) {
+    AsteroidSize largest = ASTEROID_SMALL;
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        if (state->asteroids[i].isActive && state->asteroids[i].size < largest) largest = state->asteroids[i].size;
+    }
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        if (state->asteroids[i].isActive && state->asteroids[i].size == largest) ShatterAsteroid(state, i);
+    }
+}
+
+// Held for eight ticks at a time, from the tick alone so the script has no state
+static unsigned int GetScriptedActions(uint32_t tick) {
+    static const unsigned int patterns[] = {
+        ACTION_THRUST | ACTION_FIRE,
+        ACTION_ROTATE_LEFT | ACTION_FIRE,
+        ACTION_ROTATE_RIGHT | ACTION_THRUST,
+        ACTION_FIRE,
+        ACTION_ROTATE_LEFT | ACTION_THRUST | ACTION_FIRE,
+        ACTION_ROTATE_RIGHT | ACTION_FIRE
+    };
+    return patterns[(tick / 8) % (sizeof(patterns) / sizeof(patterns[0]))];
+}
+
+static void StartScenario(GameState* state, ScenarioId id, int asteroids) {
+    state->levelSet = LEVEL_SET_SWARM;
+    StartNewGame(state);
+    
+    // Clear the level's own asteroids and keep the pilot alive for the whole run
+    memset(state->asteroids, 0, state->maxAsteroids * sizeof(Asteroid));
+    state->asteroidCount = 0;
+    state->ship.isInvulnerable = true;
+    CancelTimer(&state->timers, TIMER_SHIP_INVULNERABLE);
+    
+    FillAsteroids(state, asteroids, id == SCENARIO_BULLET_HELL ? ASTEROID_SMALL : ASTEROID_LARGE);
+}
+
+// The scenario's own events for the coming tick; returns the pilot's controls
+static unsigned int StepScenario(GameState* state, ScenarioId id, int asteroids) {
+    uint32_t tick = state->tick;
+    
+    // A cleared field refills here rather than advancing the level
+    CancelTimer(&state->timers, TIMER_NEXT_LEVEL);
+    
+    switch (id) {
+        case SCENARIO_WAVES:
+            if (tick % SCENARIO_WAVE_INTERVAL == 0) {
+                FillAsteroids(state, asteroids - state->asteroidCount, ASTEROID_LARGE);
+            }
+            break;
+            
+        case SCENARIO_BULLET_HELL:
+            // The shortest delay comes due within this tick, so each UFO fires every tick
+            for (int i = 0; i < MAX_UFOS; i++) {
+                if (!state->ufos[i].isActive) SpawnUFO(state);
+                ScheduleTimer(&state->timers, TIMER_UFO_SHOOT + i, 0);
+            }
+            if (state->asteroidCount < asteroids / 2) {
+                FillAsteroids(state, asteroids - state->asteroidCount, ASTEROID_SMALL);
+            }
+            break;
+            
+        case SCENARIO_SPLIT_STORM:
+            if (state->asteroidCount == 0) {
+                FillAsteroids(state, asteroids, ASTEROID_LARGE);
+            } else if (tick % SCENARIO_STORM_INTERVAL == 0) {
+                SplitLargestAsteroids(state);
+            }
+            break;
+            
+        case SCENARIO_COUNT:
+            break;
+    }
+    return GetScriptedActions(tick);
+}
+
+static int CountActiveEntities(const GameState* state) {
+    int count = state->ship.isAlive ? 1 : 0;
+    count += state->asteroidCount;
+    for (int i = 0; i < MAX_BULLETS; i++) count += state->bullets[i].isActive;
+    for (int i = 0; i < MAX_UFOS; i++) count += state->ufos[i].isActive;
+    return count;
+}
+
+// The state needs at least asteroids slots; swarm-sized states fit every count
+void BeginScenarioRun(ScenarioRun* run, GameState* state, ScenarioId id, int asteroids) {
+    *run = (ScenarioRun){ .id = id, .asteroids = asteroids };
+    StartScenario(state, id, asteroids);
+}
+
+// Ticks before SCENARIO_WARMUP_TICKS run but are not measured
+void StepScenarioRun(ScenarioRun* run, GameState* state) {
+    ScenarioSample* sample = &run->sample;
+    bool measured = run->tick >= SCENARIO_WARMUP_TICKS;
+    run->tick++;
+    
+    double start = GetMonotonicTime();
+    ApplyShipActions(state, StepScenario(state, run->id, run->asteroids));
+    double scripted = GetMonotonicTime();
+    
+    SetGamePhaseProfile(measured ? &sample->phases : nullptr);
+    UpdateGame(state, SCENARIO_TICK_DT);
+    SetGamePhaseProfile(nullptr);
+    double tickTime = GetMonotonicTime() - scripted;
+    
+    if (!measured) return;
+    sample->ticks++;
+    sample->entities += CountActiveEntities(state);
+    sample->scriptTime += scripted - start;
+    sample->tickTime += tickTime;
+    if (tickTime > sample->worstTick) sample->worstTick = tickTime;
+}
+
+// Rendered runs add each frame's work, update and drawing, once its tick is measured
+void AddScenarioFrameTime(ScenarioRun* run, double seconds) {
+    if (run->tick <= SCENARIO_WARMUP_TICKS) return;
+    run->sample.frames++;
+    run->sample.frameTime += seconds;
+    if (seconds > run->sample.worstFrame) run->sample.worstFrame = seconds;
+}
+
+bool IsScenarioRunDone(const ScenarioRun* run, int ticks) {
+    return run->sample.ticks >= ticks;
+}
+
+// Columns of per-tick means in microseconds, one row per point, ready to plot
+void WriteScenarioHeader(FILE* out, bool rendered) {
+    fprintf(out, "# %-11s %9s %9s %9s %9s", "scenario", "asteroids", "entities", "tick_us", "worst_us");
+    if (rendered) fprintf(out, " %9s %9s", "frame_us", "worstf_us");
+    fprintf(out, " %9s", "script");
+    for (int p = 0; p < GAME_PHASE_COUNT; p++) {
+        fprintf(out, " %10s", GetGamePhaseName(p));
+    }
+    fprintf(out, "\n");
+}
+
+void WriteScenarioSample(FILE* out, const ScenarioRun* run, bool rendered) {
+    const ScenarioSample* sample = &run->sample;
+    double ticks = sample->ticks > 0 ? sample->ticks : 1;
+    double frames = sample->frames > 0 ? sample->frames : 1;
+    
+    fprintf(out, "  %-11s %9d %9.0f %9.1f %9.1f", GetScenarioName(run->id), run->asteroids,
+            sample->entities / ticks, sample->tickTime / ticks * 1e6, sample->worstTick * 1e6);
+    if (rendered) fprintf(out, " %9.1f %9.1f", sample->frameTime / frames * 1e6, sample->worstFrame * 1e6);
+    fprintf(out, " %9.1f", sample->scriptTime / ticks * 1e6);
+    for (int p = 0; p < GAME_PHASE_COUNT; p++) {
+        fprintf(out, " %10.1f", sample->phases.seconds[p] / ticks * 1e6);
+    }
+    fprintf(out, "\n");
+    fflush(out);
+}
@@ -0,0 +1,64 @@
+#ifndef SCENARIOS_H
+#define SCENARIOS_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+// Scripted stress scenarios for measuring how the rules scale. Each runs a
+// swarm-sized game at a chosen asteroid count with an invulnerable scripted
+// pilot, and a ScenarioRun times its ticks by UpdateGame phase. The same runs
+// drive `bin/stress` headlessly and the game window with --stress.
+//
+// Bullets and UFOs have fixed pools (MAX_BULLETS, MAX_UFOS), so scenarios
+// load those to capacity and sweep the asteroid count.
+
+#define SCENARIO_TICK_DT (1.0f / 60.0f)
+#define SCENARIO_WARMUP_TICKS 60
+#define SCENARIO_DEFAULT_TICKS 600
+#define SCENARIO_MAX_COUNTS 16
+
+typedef enum {
+    SCENARIO_WAVES,
+    SCENARIO_BULLET_HELL,
+    SCENARIO_SPLIT_STORM,
+    SCENARIO_COUNT
+} ScenarioId;
+
+// Sums over the measured ticks; frame times only when rendered
+typedef struct {
+    int ticks;
+    double entities;
+    double scriptTime;
+    double tickTime;
+    double worstTick;
+    int frames;
+    double frameTime;
+    double worstFrame;
+    GamePhaseTimes phases;
+} ScenarioSample;
+
+// One point of a sweep: a scenario at one asteroid count
+typedef struct {
+    ScenarioId id;
+    int asteroids;
+    int tick;
+    ScenarioSample sample;
+} ScenarioRun;
+
+int FindScenario(const char* name);
+const char* GetScenarioName(ScenarioId id);
+const char* GetScenarioDescription(ScenarioId id);
+
+// Comma-separated counts, or doubling from 64 to maxCount for nullptr; returns how many
+int ParseScenarioCounts(const char* list, int maxCount, int counts[SCENARIO_MAX_COUNTS]);
+
+void BeginScenarioRun(ScenarioRun* run, GameState* state, ScenarioId id, int asteroids);
+void StepScenarioRun(ScenarioRun* run, GameState* state);
+void AddScenarioFrameTime(ScenarioRun* run, double seconds);
+bool IsScenarioRunDone(const ScenarioRun* run, int ticks);
+
+void WriteScenarioHeader(FILE* out, bool rendered);
+void WriteScenarioSample(FILE* out, const ScenarioRun* run, bool rendered);
+
+#endif
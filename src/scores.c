@@ -0,0 +1,714 @@
+#define _POSIX_C_SOURCE 200809L
+#include "scores.h"
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(PLATFORM_WEB)
+    #include <emscripten/emscripten.h>
+#else
+    #include <pthread.h>
+#endif
+
+#define SCORE_LOG_MAGIC 0x474C5341u    // "ASLG"
+#define SCORE_INDEX_MAGIC 0x58495341u  // "ASIX"
+#define SCORE_FORMAT_VERSION 1
+#define SCORE_QUEUE_CAPACITY 256
+#define SCORE_COMPACT_THRESHOLD 1024
+// Index entries the web build merges per frame while compacting
+#define SCORE_COMPACT_STEP_ENTRIES 8192
+#define SCORE_PATH_SIZE 512
+#define SCORE_MAX_DIRECTORY_LENGTH (SCORE_PATH_SIZE - sizeof("/scores.log"))
+#define SCORE_LOG_BUFFER_SIZE 65536
+#define SCORE_WEB_DIRECTORY "/data"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+} ScoreLogHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+} ScoreIndexHeader;
+
+// Index entries run best score first; ties keep log order
+typedef struct {
+    int32_t score;
+    uint32_t record;
+} ScoreIndexEntry;
+
+// Records newer than the index stay in memory, in rank order, until the next compaction
+typedef struct {
+    ScoreRecord record;
+    uint32_t index;
+} PendingScore;
+
+// An index rewrite in progress; fresh holds the pending records being folded in
+typedef struct {
+    FILE* file;
+    char temporary[SCORE_PATH_SIZE + 8];
+    ScoreIndexEntry* fresh;
+    int freshCount;
+    int b;
+    const ScoreIndexEntry* old;
+    uint32_t oldCount;
+    uint32_t a;
+    uint32_t covered;
+    bool written;
+} ScoreCompaction;
+
+typedef struct {
+    bool open;
+    bool failed;
+    char directory[SCORE_PATH_SIZE];
+    char logPath[SCORE_PATH_SIZE];
+    char indexPath[SCORE_PATH_SIZE];
+    
+    FILE* log;
+    int readFd;
+    
+    void* indexMapping;
+    size_t indexLength;
+    const ScoreIndexEntry* indexEntries;
+    uint32_t indexCount;
+    
+    PendingScore* pending;
+    int pendingCount;
+    int pendingCapacity;
+    
+    uint32_t recordCount;
+    uint32_t writtenCount;
+    uint32_t compactedThrough;
+    
+    ScoreRecord queue[SCORE_QUEUE_CAPACITY];
+    int queueHead;
+    int queueCount;
+
+#if defined(PLATFORM_WEB)
+    bool loading;
+    bool dirty;
+    bool compacting;
+    ScoreCompaction compaction;
+#else
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool quit;
+#endif
+} ScoreStore;
+
+static ScoreStore store = { .readFd = -1 };
+
+#if defined(PLATFORM_WEB)
+    #define LockStore() ((void)0)
+    #define UnlockStore() ((void)0)
+#else
+    #define LockStore() pthread_mutex_lock(&store.lock)
+    #define UnlockStore() pthread_mutex_unlock(&store.lock)
+#endif
+
+// FNV-1a over the record with its checksum field zeroed
+static uint32_t ChecksumRecord(const ScoreRecord* record) {
+    ScoreRecord copy = *record;
+    copy.checksum = 0;
+    
+    const unsigned char* bytes = (const unsigned char*)&copy;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(copy); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool RanksBefore(int32_t scoreA, uint32_t recordA, int32_t scoreB, uint32_t recordB) {
+    return scoreA > scoreB || (scoreA == scoreB && recordA < recordB);
+}
+
+static int ComparePending(const void* a, const void* b) {
+    const PendingScore* left = a;
+    const PendingScore* right = b;
+    if (RanksBefore(left->record.score, left->index, right->record.score, right->index)) return -1;
+    if (RanksBefore(right->record.score, right->index, left->record.score, left->index)) return 1;
+    return 0;
+}
+
+static bool ReservePending(int capacity) {
+    if (capacity <= store.pendingCapacity) return true;
+    
+    int grown = store.pendingCapacity ? store.pendingCapacity * 2 : 64;
+    if (grown < capacity) grown = capacity;
+    
+    PendingScore* pending = realloc(store.pending, grown * sizeof(PendingScore));
+    if (!pending) return false;
+    
+    store.pending = pending;
+    store.pendingCapacity = grown;
+    return true;
+}
+
+static void InsertPending(const ScoreRecord* record, uint32_t index) {
+    if (!ReservePending(store.pendingCount + 1)) return;
+    
+    int slot = store.pendingCount;
+    while (slot > 0 && RanksBefore(record->score, index, store.pending[slot - 1].record.score, store.pending[slot - 1].index)) {
+        store.pending[slot] = store.pending[slot - 1];
+        slot--;
+    }
+    store.pending[slot] = (PendingScore){ *record, index };
+    store.pendingCount++;
+}
+
+static bool MapIndex(const char* path, void** mapping, size_t* length, uint32_t* count) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(ScoreIndexHeader)) {
+        close(fd);
+        return false;
+    }
+    
+    *length = (size_t)info.st_size;
+    *mapping = mmap(nullptr, *length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (*mapping == MAP_FAILED) return false;
+    
+    const ScoreIndexHeader* header = *mapping;
+    size_t expected = sizeof(ScoreIndexHeader) + (size_t)header->count * sizeof(ScoreIndexEntry);
+    if (header->magic != SCORE_INDEX_MAGIC || header->version != SCORE_FORMAT_VERSION || *length < expected) {
+        munmap(*mapping, *length);
+        return false;
+    }
+    
+    *count = header->count;
+    return true;
+}
+
+static void ReleaseIndex(void) {
+    if (store.indexMapping) {
+        munmap(store.indexMapping, store.indexLength);
+    }
+    store.indexMapping = nullptr;
+    store.indexEntries = nullptr;
+    store.indexLength = 0;
+    store.indexCount = 0;
+}
+
+static off_t RecordOffset(uint32_t index) {
+    return (off_t)sizeof(ScoreLogHeader) + (off_t)index * (off_t)sizeof(ScoreRecord);
+}
+
+static bool WriteLogHeader(void) {
+    FILE* file = fopen(store.logPath, "wb");
+    if (!file) return false;
+    
+    ScoreLogHeader header = { SCORE_LOG_MAGIC, SCORE_FORMAT_VERSION };
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    written = (fflush(file) == 0) && written;
+    fsync(fileno(file));
+    return (fclose(file) == 0) && written;
+}
+
+// Reads the records the index does not cover yet. A torn or corrupt record
+// ends the log; everything after it is cut off so appends stay aligned.
+static bool ScanLogTail(void) {
+    FILE* file = fopen(store.logPath, "rb");
+    ScoreLogHeader header;
+    
+    if (!file || fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != SCORE_LOG_MAGIC || header.version != SCORE_FORMAT_VERSION) {
+        if (file) {
+            fclose(file);
+            fprintf(stderr, "Score log is unreadable, starting a new one: %s\n", store.logPath);
+        }
+        ReleaseIndex();
+        return WriteLogHeader();
+    }
+    
+    // An index covering more than the log describes some other log
+    fseeko(file, 0, SEEK_END);
+    off_t size = ftello(file);
+    if (RecordOffset(store.indexCount) > size) {
+        ReleaseIndex();
+    }
+    
+    uint32_t index = store.indexCount;
+    fseeko(file, RecordOffset(index), SEEK_SET);
+    
+    ScoreRecord record;
+    while (fread(&record, sizeof(record), 1, file) == 1 && record.checksum == ChecksumRecord(&record)) {
+        if (!ReservePending(store.pendingCount + 1)) break;
+        store.pending[store.pendingCount++] = (PendingScore){ record, index++ };
+    }
+    fclose(file);
+    
+    if (RecordOffset(index) < size && truncate(store.logPath, RecordOffset(index)) != 0) {
+        return false;
+    }
+    
+    qsort(store.pending, store.pendingCount, sizeof(PendingScore), ComparePending);
+    store.recordCount = index;
+    store.writtenCount = index;
+    return true;
+}
+
+// Merges the durable pending records into a new index, written beside the
+// old one and renamed over it so readers only ever see a complete file.
+// The merge runs in steps so the web build can spread it across frames.
+static bool BeginCompaction(ScoreCompaction* job) {
+    LockStore();
+    uint32_t covered = store.writtenCount;
+    store.compactedThrough = covered;
+    int count = 0;
+    ScoreIndexEntry* fresh = malloc(store.pendingCount * sizeof(ScoreIndexEntry) + 1);
+    if (fresh) {
+        for (int i = 0; i < store.pendingCount; i++) {
+            if (store.pending[i].index < covered) {
+                fresh[count++] = (ScoreIndexEntry){ store.pending[i].record.score, store.pending[i].index };
+            }
+        }
+    }
+    const ScoreIndexEntry* old = store.indexEntries;
+    uint32_t oldCount = store.indexCount;
+    UnlockStore();
+    
+    if (!fresh) return false;
+    if (count == 0) {
+        free(fresh);
+        return false;
+    }
+    
+    *job = (ScoreCompaction){ .fresh = fresh, .freshCount = count, .old = old, .oldCount = oldCount, .covered = covered };
+    snprintf(job->temporary, sizeof(job->temporary), "%s.tmp", store.indexPath);
+    job->file = fopen(job->temporary, "wb");
+    if (!job->file) {
+        free(fresh);
+        return false;
+    }
+    setvbuf(job->file, nullptr, _IOFBF, SCORE_LOG_BUFFER_SIZE);
+    
+    ScoreIndexHeader header = { SCORE_INDEX_MAGIC, SCORE_FORMAT_VERSION, oldCount + count, 0 };
+    job->written = fwrite(&header, sizeof(header), 1, job->file) == 1;
+    return true;
+}
+
+// Writes up to maxEntries merged entries; returns true once the merge is done or has failed
+static bool StepCompaction(ScoreCompaction* job, long maxEntries) {
+    // The old index is only replaced by compaction, so it can be read without the lock
+    const ScoreIndexEntry* old = job->old;
+    const ScoreIndexEntry* fresh = job->fresh;
+    for (; job->written && (job->a < job->oldCount || job->b < job->freshCount) && maxEntries > 0; maxEntries--) {
+        bool takeOld = job->b >= job->freshCount ||
+            (job->a < job->oldCount && RanksBefore(old[job->a].score, old[job->a].record,
+                                                   fresh[job->b].score, fresh[job->b].record));
+        job->written = fwrite(takeOld ? &old[job->a++] : &fresh[job->b++], sizeof(ScoreIndexEntry), 1, job->file) == 1;
+    }
+    return !job->written || (job->a >= job->oldCount && job->b >= job->freshCount);
+}
+
+static void FinishCompaction(ScoreCompaction* job) {
+    bool written = job->written;
+    written = (fflush(job->file) == 0) && written;
+    written = (fsync(fileno(job->file)) == 0) && written;
+    written = (fclose(job->file) == 0) && written;
+    free(job->fresh);
+    job->file = nullptr;
+    job->fresh = nullptr;
+    
+    void* mapping;
+    size_t length;
+    uint32_t mappedCount;
+    if (!written || rename(job->temporary, store.indexPath) != 0 ||
+        !MapIndex(store.indexPath, &mapping, &length, &mappedCount)) {
+        remove(job->temporary);
+        return;
+    }
+    
+    LockStore();
+    void* oldMapping = store.indexMapping;
+    size_t oldLength = store.indexLength;
+    store.indexMapping = mapping;
+    store.indexLength = length;
+    store.indexEntries = (const ScoreIndexEntry*)((const unsigned char*)mapping + sizeof(ScoreIndexHeader));
+    store.indexCount = mappedCount;
+    
+    int kept = 0;
+    for (int i = 0; i < store.pendingCount; i++) {
+        if (store.pending[i].index >= job->covered) {
+            store.pending[kept++] = store.pending[i];
+        }
+    }
+    store.pendingCount = kept;
+    UnlockStore();
+    
+    if (oldMapping) {
+        munmap(oldMapping, oldLength);
+    }
+}
+
+#if !defined(PLATFORM_WEB)
+static void CompactScores(void) {
+    ScoreCompaction job;
+    if (!BeginCompaction(&job)) return;
+    
+    StepCompaction(&job, LONG_MAX);
+    FinishCompaction(&job);
+}
+#endif
+
+static bool AppendRecords(const ScoreRecord* records, int count) {
+    if (store.failed) return false;
+    
+    bool written = fwrite(records, sizeof(ScoreRecord), count, store.log) == (size_t)count;
+    written = (fflush(store.log) == 0) && written;
+#if !defined(PLATFORM_WEB)
+    written = (fsync(fileno(store.log)) == 0) && written;
+#endif
+
+    if (!written) {
+        fprintf(stderr, "Failed to write score log: %s\n", store.logPath);
+        store.failed = true;
+    }
+    return written;
+}
+
+#if !defined(PLATFORM_WEB)
+static void* ScoreWriter(void* arg) {
+    (void)arg;
+    ScoreRecord batch[SCORE_QUEUE_CAPACITY];
+    
+    pthread_mutex_lock(&store.lock);
+    for (;;) {
+        // A failed store never compacts, so it must not count as compaction work either
+        while (store.queueCount == 0 && !store.quit &&
+               !(!store.failed && store.pendingCount >= SCORE_COMPACT_THRESHOLD &&
+                 store.writtenCount > store.compactedThrough)) {
+            pthread_cond_wait(&store.wake, &store.lock);
+        }
+        
+        int count = store.queueCount;
+        for (int i = 0; i < count; i++) {
+            batch[i] = store.queue[(store.queueHead + i) % SCORE_QUEUE_CAPACITY];
+        }
+        store.queueHead = (store.queueHead + count) % SCORE_QUEUE_CAPACITY;
+        store.queueCount = 0;
+        bool quit = store.quit;
+        pthread_mutex_unlock(&store.lock);
+        
+        if (count > 0 && AppendRecords(batch, count)) {
+            pthread_mutex_lock(&store.lock);
+            store.writtenCount += count;
+            pthread_mutex_unlock(&store.lock);
+        }
+        
+        pthread_mutex_lock(&store.lock);
+        // A failed compaction is retried only once more records have been written
+        bool compact = store.pendingCount >= SCORE_COMPACT_THRESHOLD && store.writtenCount > store.compactedThrough;
+        pthread_mutex_unlock(&store.lock);
+        if (compact && !store.failed) {
+            CompactScores();
+        }
+        
+        pthread_mutex_lock(&store.lock);
+        if (quit && store.queueCount == 0) break;
+    }
+    pthread_mutex_unlock(&store.lock);
+    return nullptr;
+}
+#endif
+
+static void EnqueueRecord(const ScoreRecord* record) {
+    int tail = (store.queueHead + store.queueCount) % SCORE_QUEUE_CAPACITY;
+    store.queue[tail] = *record;
+    store.queueCount++;
+}
+
+static bool FinishOpen(void) {
+    int logLength = snprintf(store.logPath, sizeof(store.logPath), "%s/scores.log", store.directory);
+    int indexLength = snprintf(store.indexPath, sizeof(store.indexPath), "%s/scores.idx", store.directory);
+    if (logLength >= (int)sizeof(store.logPath) || indexLength >= (int)sizeof(store.indexPath)) return false;
+    
+    void* mapping;
+    size_t length;
+    uint32_t count;
+    if (MapIndex(store.indexPath, &mapping, &length, &count)) {
+        store.indexMapping = mapping;
+        store.indexLength = length;
+        store.indexEntries = (const ScoreIndexEntry*)((const unsigned char*)mapping + sizeof(ScoreIndexHeader));
+        store.indexCount = count;
+    }
+    
+    if (!ScanLogTail()) return false;
+    
+    store.log = fopen(store.logPath, "ab");
+    store.readFd = open(store.logPath, O_RDONLY);
+    if (!store.log || store.readFd < 0) return false;
+    setvbuf(store.log, nullptr, _IOFBF, SCORE_LOG_BUFFER_SIZE);
+    
+    store.open = true;
+    return true;
+}
+
+#if defined(PLATFORM_WEB)
+// Records submitted while IndexedDB is still loading wait in the queue
+static void FlushQueuedScores(void) {
+    int count = store.queueCount;
+    store.queueCount = 0;
+    for (int i = 0; i < count; i++) {
+        ScoreRecord record = store.queue[(store.queueHead + i) % SCORE_QUEUE_CAPACITY];
+        SubmitScore(record.score, record.level, record.duration, record.seed);
+    }
+    store.queueHead = 0;
+}
+#endif
+
+bool OpenScoreStore(const char* directory) {
+    if (store.open) return true;
+
+#if defined(PLATFORM_WEB)
+    (void)directory;
+    snprintf(store.directory, sizeof(store.directory), "%s", SCORE_WEB_DIRECTORY);
+    store.loading = true;
+    EM_ASM({
+        Module.scoreStoreReady = 0;
+        Module.scoreStoreSyncing = 0;
+        FS.mkdir(UTF8ToString($0));
+        FS.mount(IDBFS, {}, UTF8ToString($0));
+        FS.syncfs(true, function(err) {
+            Module.scoreStoreReady = err ? -1 : 1;
+        });
+    }, SCORE_WEB_DIRECTORY);
+    return true;
+#else
+    // The file names are appended to the directory, so it has to leave room for them
+    if (strlen(directory) > SCORE_MAX_DIRECTORY_LENGTH) {
+        fprintf(stderr, "Score directory path is too long: %s\n", directory);
+        return false;
+    }
+    
+    snprintf(store.directory, sizeof(store.directory), "%s", directory);
+    if (mkdir(store.directory, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Failed to create score directory: %s\n", store.directory);
+        return false;
+    }
+    
+    if (!FinishOpen()) {
+        fprintf(stderr, "Failed to open score log: %s\n", store.logPath);
+        CloseScoreStore();
+        return false;
+    }
+    
+    pthread_mutex_init(&store.lock, nullptr);
+    pthread_cond_init(&store.wake, nullptr);
+    store.quit = false;
+    if (pthread_create(&store.writer, nullptr, ScoreWriter, nullptr) != 0) {
+        pthread_mutex_destroy(&store.lock);
+        pthread_cond_destroy(&store.wake);
+        store.open = false;
+        CloseScoreStore();
+        return false;
+    }
+    
+    // A large backlog from an old or missing index gets folded in right away
+    if (store.pendingCount >= SCORE_COMPACT_THRESHOLD) {
+        pthread_cond_signal(&store.wake);
+    }
+    return true;
+#endif
+}
+
+void CloseScoreStore(void) {
+#if defined(PLATFORM_WEB)
+    // An unfinished compaction is dropped; the log still holds every record
+    if (store.compacting) {
+        fclose(store.compaction.file);
+        remove(store.compaction.temporary);
+        free(store.compaction.fresh);
+    }
+    if (store.open && store.dirty) {
+        EM_ASM({ FS.syncfs(false, function(err) {}); });
+    }
+    store.loading = false;
+#else
+    if (store.open) {
+        pthread_mutex_lock(&store.lock);
+        store.quit = true;
+        pthread_cond_signal(&store.wake);
+        pthread_mutex_unlock(&store.lock);
+        pthread_join(store.writer, nullptr);
+        pthread_mutex_destroy(&store.lock);
+        pthread_cond_destroy(&store.wake);
+    }
+#endif
+
+    if (store.log) fclose(store.log);
+    if (store.readFd >= 0) close(store.readFd);
+    ReleaseIndex();
+    free(store.pending);
+    
+    store = (ScoreStore){ .readFd = -1 };
+}
+
+void UpdateScoreStore(void) {
+#if defined(PLATFORM_WEB)
+    if (store.loading) {
+        int ready = EM_ASM_INT({ return Module.scoreStoreReady; });
+        if (ready == 0) return;
+        
+        store.loading = false;
+        if (ready < 0 || !FinishOpen()) {
+            fprintf(stderr, "Failed to load saved scores\n");
+            store.queueCount = 0;
+            return;
+        }
+        FlushQueuedScores();
+    }
+    
+    if (!store.open) return;
+    
+    // Compaction advances a bounded step per frame instead of rewriting the index in one go
+    if (!store.compacting && !store.failed && store.pendingCount >= SCORE_COMPACT_THRESHOLD &&
+        store.writtenCount > store.compactedThrough) {
+        store.compacting = BeginCompaction(&store.compaction);
+    }
+    if (store.compacting && StepCompaction(&store.compaction, SCORE_COMPACT_STEP_ENTRIES)) {
+        FinishCompaction(&store.compaction);
+        store.compacting = false;
+        store.dirty = true;
+    }
+    
+    // Only one sync runs at a time; writes made meanwhile go out with the next one.
+    // A half-written index is not worth persisting, so syncs wait for compaction to finish.
+    if (store.dirty && !store.compacting && EM_ASM_INT({ return Module.scoreStoreSyncing; }) == 0) {
+        store.dirty = false;
+        EM_ASM({
+            Module.scoreStoreSyncing = 1;
+            FS.syncfs(false, function(err) { Module.scoreStoreSyncing = 0; });
+        });
+    }
+#endif
+}
+
+void SubmitScore(int score, int level, float duration, uint64_t seed) {
+    ScoreRecord record = {
+        .score = score,
+        .level = level,
+        .duration = duration,
+        .seed = seed,
+        .timestamp = (int64_t)time(nullptr)
+    };
+    record.checksum = ChecksumRecord(&record);
+
+#if defined(PLATFORM_WEB)
+    if (store.loading) {
+        if (store.queueCount < SCORE_QUEUE_CAPACITY) EnqueueRecord(&record);
+        return;
+    }
+    if (!store.open || store.failed) return;
+    
+    // MEMFS writes are memory copies; persistence happens in the async sync
+    InsertPending(&record, store.recordCount++);
+    if (AppendRecords(&record, 1)) {
+        store.writtenCount = store.recordCount;
+        store.dirty = true;
+    }
+#else
+    if (!store.open) return;
+    
+    LockStore();
+    if (store.failed || store.queueCount == SCORE_QUEUE_CAPACITY) {
+        UnlockStore();
+        return;
+    }
+    InsertPending(&record, store.recordCount++);
+    EnqueueRecord(&record);
+    pthread_cond_signal(&store.wake);
+    UnlockStore();
+#endif
+}
+
+int GetBestScore(void) {
+    if (!store.open) return 0;
+    
+    LockStore();
+    int best = 0;
+    if (store.indexCount > 0 && store.indexEntries[0].score > best) {
+        best = store.indexEntries[0].score;
+    }
+    if (store.pendingCount > 0 && store.pending[0].record.score > best) {
+        best = store.pending[0].record.score;
+    }
+    UnlockStore();
+    return best;
+}
+
+// Walks the index and the pending list together; indexed records are read
+// straight from the log since only their scores live in the index
+int GetTopScores(ScoreRecord* records, int maxRecords) {
+    if (!store.open) return 0;
+    
+    LockStore();
+    uint32_t a = 0;
+    int b = 0;
+    int count = 0;
+    
+    while (count < maxRecords && (a < store.indexCount || b < store.pendingCount)) {
+        bool takeIndex = b >= store.pendingCount ||
+            (a < store.indexCount && RanksBefore(store.indexEntries[a].score, store.indexEntries[a].record,
+                                                 store.pending[b].record.score, store.pending[b].index));
+        if (takeIndex) {
+            ssize_t bytes = pread(store.readFd, &records[count], sizeof(ScoreRecord),
+                                  RecordOffset(store.indexEntries[a].record));
+            a++;
+            if (bytes == (ssize_t)sizeof(ScoreRecord)) count++;
+        } else {
+            records[count++] = store.pending[b++].record;
+        }
+    }
+    
+    UnlockStore();
+    return count;
+}
+
+// 1-based position a game with this score would take on the leaderboard
+long GetScoreRank(int score) {
+    if (!store.open) return 1;
+    
+    LockStore();
+    uint32_t low = 0;
+    uint32_t high = store.indexCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (store.indexEntries[middle].score > score) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    
+    long rank = (long)low + 1;
+    for (int i = 0; i < store.pendingCount && store.pending[i].record.score > score; i++) {
+        rank++;
+    }
+    UnlockStore();
+    return rank;
+}
+
+long GetScoreRecordCount(void) {
+    if (!store.open) return 0;
+    
+    LockStore();
+    long count = store.recordCount;
+    UnlockStore();
+    return count;
+}
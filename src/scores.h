@@ -0,0 +1,31 @@
+#ifndef SCORES_H
+#define SCORES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Finished games are appended to a checksummed log and ranked through a
+// sorted index file that is replaced by atomic rename. Submitting never
+// blocks the frame: desktop builds hand records to a writer thread, and web
+// builds write to an IndexedDB-backed directory that syncs in the background.
+
+typedef struct {
+    int32_t score;
+    int32_t level;
+    float duration;
+    uint32_t checksum;
+    uint64_t seed;
+    int64_t timestamp;
+} ScoreRecord;
+
+bool OpenScoreStore(const char* directory);
+void CloseScoreStore(void);
+void UpdateScoreStore(void);
+
+void SubmitScore(int score, int level, float duration, uint64_t seed);
+int GetBestScore(void);
+int GetTopScores(ScoreRecord* records, int maxRecords);
+long GetScoreRank(int score);
+long GetScoreRecordCount(void);
+
+#endif
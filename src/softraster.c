@@ -0,0 +1,246 @@
+#include "softraster.h"
+#include "world.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPAN_LANE_WIDTH SOFT_FRAMEBUFFER_ALIGNMENT
+#define SHIP_VALUE 255
+#define ASTEROID_VALUE 255
+#define UFO_VALUE 255
+#define BULLET_VALUE 255
+#define FLAME_VALUE 160
+// Asteroids further than this outside the view cannot touch the framebuffer
+#define ASTEROID_CULL_REACH (ASTEROID_LARGE_RADIUS * ASTEROID_SHAPE_MAX_SCALE)
+
+typedef unsigned char SpanLane __attribute__((vector_size(SPAN_LANE_WIDTH)));
+
+typedef struct {
+    const GameState* const* states;
+    SoftFramebuffer* framebuffers;
+} RasterBatch;
+
+// World to framebuffer: shift into view space as the GPU camera does, then scale
+typedef struct {
+    Vector2 shift;
+    Vector2 scale;
+} RasterTransform;
+
+// Rows are padded to whole lanes so span fills never need a scalar head
+static int GetSoftFramebufferStride(int width) {
+    return (width + SPAN_LANE_WIDTH - 1) / SPAN_LANE_WIDTH * SPAN_LANE_WIDTH;
+}
+
+size_t GetSoftFramebufferBytes(int width, int height) {
+    return (size_t)GetSoftFramebufferStride(width) * height;
+}
+
+SoftFramebuffer InitSoftFramebuffer(int width, int height, unsigned char* pixels) {
+    SoftFramebuffer framebuffer = {0};
+    if (!pixels) return framebuffer;
+    
+    framebuffer.pixels = pixels;
+    framebuffer.width = width;
+    framebuffer.height = height;
+    framebuffer.stride = GetSoftFramebufferStride(width);
+    memset(framebuffer.pixels, 0, GetSoftFramebufferBytes(width, height));
+    return framebuffer;
+}
+
+SoftFramebuffer CreateSoftFramebuffer(int width, int height) {
+    return InitSoftFramebuffer(width, height, aligned_alloc(SPAN_LANE_WIDTH, GetSoftFramebufferBytes(width, height)));
+}
+
+void DestroySoftFramebuffer(SoftFramebuffer* framebuffer) {
+    free(framebuffer->pixels);
+    *framebuffer = (SoftFramebuffer){0};
+}
+
+void ClearSoftFramebuffer(SoftFramebuffer* framebuffer, unsigned char value) {
+    memset(framebuffer->pixels, value, (size_t)framebuffer->stride * framebuffer->height);
+}
+
+// Fills [x0, x1] on one row with 16-byte vector stores plus a scalar tail
+static void FillSpan(unsigned char* row, int x0, int x1, unsigned char value) {
+    int x = x0;
+    
+    while (x <= x1 && (x % SPAN_LANE_WIDTH) != 0) {
+        row[x++] = value;
+    }
+    
+    SpanLane lane;
+    memset(&lane, value, sizeof(lane));
+    for (; x + SPAN_LANE_WIDTH - 1 <= x1; x += SPAN_LANE_WIDTH) {
+        *(SpanLane*)(row + x) = lane;
+    }
+    
+    for (; x <= x1; x++) {
+        row[x] = value;
+    }
+}
+
+static void PlotPixel(SoftFramebuffer* framebuffer, int x, int y, unsigned char value) {
+    if ((unsigned)x < (unsigned)framebuffer->width && (unsigned)y < (unsigned)framebuffer->height) {
+        framebuffer->pixels[y * framebuffer->stride + x] = value;
+    }
+}
+
+// Integer Bresenham on pixel centres; pixels outside the framebuffer are discarded
+void SoftDrawLine(SoftFramebuffer* framebuffer, Vector2 from, Vector2 to, unsigned char value) {
+    int x0 = (int)floorf(from.x);
+    int y0 = (int)floorf(from.y);
+    int x1 = (int)floorf(to.x);
+    int y1 = (int)floorf(to.y);
+    
+    if ((x0 < 0 && x1 < 0) || (y0 < 0 && y1 < 0) ||
+        (x0 >= framebuffer->width && x1 >= framebuffer->width) ||
+        (y0 >= framebuffer->height && y1 >= framebuffer->height)) {
+        return;
+    }
+    
+    int dx = abs(x1 - x0);
+    int dy = -abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int error = dx + dy;
+    
+    for (;;) {
+        PlotPixel(framebuffer, x0, y0, value);
+        if (x0 == x1 && y0 == y1) break;
+        
+        int e2 = 2 * error;
+        if (e2 >= dy) {
+            error += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            error += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void SoftFillCircle(SoftFramebuffer* framebuffer, Vector2 center, float radius, unsigned char value) {
+    int y0 = (int)floorf(center.y - radius);
+    int y1 = (int)floorf(center.y + radius);
+    if (y0 < 0) y0 = 0;
+    if (y1 >= framebuffer->height) y1 = framebuffer->height - 1;
+    
+    for (int y = y0; y <= y1; y++) {
+        float dy = (y + 0.5f) - center.y;
+        float halfWidth = radius * radius - dy * dy;
+        if (halfWidth < 0) continue;
+        halfWidth = sqrtf(halfWidth);
+        
+        int x0 = (int)floorf(center.x - halfWidth);
+        int x1 = (int)floorf(center.x + halfWidth);
+        if (x0 < 0) x0 = 0;
+        if (x1 >= framebuffer->width) x1 = framebuffer->width - 1;
+        if (x0 > x1) continue;
+        
+        FillSpan(framebuffer->pixels + y * framebuffer->stride, x0, x1, value);
+    }
+}
+
+static Vector2 ToFramebuffer(Vector2 p, RasterTransform transform) {
+    return (Vector2){(p.x + transform.shift.x) * transform.scale.x, (p.y + transform.shift.y) * transform.scale.y};
+}
+
+static bool IsAsteroidInView(const GameState* state, const Asteroid* asteroid, Vector2 shift) {
+    float x = asteroid->position.x + shift.x;
+    float y = asteroid->position.y + shift.y;
+    return x > -ASTEROID_CULL_REACH && x < state->screenWidth + ASTEROID_CULL_REACH &&
+           y > -ASTEROID_CULL_REACH && y < state->screenHeight + ASTEROID_CULL_REACH;
+}
+
+static void RasterizePlayfield(const GameState* state, SoftFramebuffer* framebuffer, Vector2 shift) {
+    RasterTransform transform = {
+        shift,
+        {framebuffer->width / state->screenWidth, framebuffer->height / state->screenHeight}
+    };
+    
+    if (IsSpaceshipVisible(&state->ship, GetShipInvulnerableTime(state))) {
+        Vector2 hull[3];
+        Vector2 flame[3];
+        GetSpaceshipOutline(&state->ship, hull, flame);
+        
+        for (int i = 0; i < 3; i++) {
+            SoftDrawLine(framebuffer, ToFramebuffer(hull[i], transform), ToFramebuffer(hull[(i + 1) % 3], transform), SHIP_VALUE);
+        }
+        if (state->ship.isThrusting) {
+            SoftDrawLine(framebuffer, ToFramebuffer(flame[0], transform), ToFramebuffer(flame[1], transform), FLAME_VALUE);
+            SoftDrawLine(framebuffer, ToFramebuffer(flame[1], transform), ToFramebuffer(flame[2], transform), FLAME_VALUE);
+        }
+    }
+    
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        const Asteroid* asteroid = &state->asteroids[i];
+        if (!asteroid->isActive || !IsAsteroidInView(state, asteroid, shift)) continue;
+        
+        Vector2 points[MAX_ASTEROID_VERTICES];
+        int count = GetAsteroidOutline(asteroid, points);
+        for (int p = 0; p < count; p++) {
+            points[p] = ToFramebuffer(points[p], transform);
+        }
+        for (int p = 0; p < count; p++) {
+            SoftDrawLine(framebuffer, points[p], points[(p + 1) % count], ASTEROID_VALUE);
+        }
+    }
+    
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        const Bullet* bullet = &state->bullets[i];
+        if (!bullet->isActive) continue;
+        
+        // Keep bullets at least one pixel wide in tiny observation frames
+        float radius = BULLET_RADIUS * transform.scale.x;
+        if (radius < 0.5f) radius = 0.5f;
+        SoftFillCircle(framebuffer, ToFramebuffer(bullet->position, transform), radius, BULLET_VALUE);
+    }
+    
+    for (int i = 0; i < MAX_UFOS; i++) {
+        const UFO* ufo = &state->ufos[i];
+        if (!ufo->isActive) continue;
+        
+        Vector2 segments[UFO_SEGMENT_COUNT * 2];
+        GetUFOSegments(ufo, segments);
+        for (int s = 0; s < UFO_SEGMENT_COUNT; s++) {
+            SoftDrawLine(framebuffer, ToFramebuffer(segments[s * 2], transform), ToFramebuffer(segments[s * 2 + 1], transform), UFO_VALUE);
+        }
+    }
+}
+
+// Only the playfield is rasterized; HUD and menu text are not part of observations
+void RasterizeGameState(const GameState* state, SoftFramebuffer* framebuffer) {
+    ClearSoftFramebuffer(framebuffer, 0);
+    
+    if (state->state != GAME_STATE_PLAYING && state->state != GAME_STATE_PAUSED) return;
+    
+    if (!IsOpenWorld(state)) {
+        RasterizePlayfield(state, framebuffer, (Vector2){0, 0});
+        return;
+    }
+    
+    // Open worlds follow DrawWorld: one pass per whole-world shift the view overlaps
+    Rectangle view = GetWorldView(state);
+    int firstLapX = (int)floorf((view.x - ASTEROID_CULL_REACH) / state->worldWidth);
+    int lastLapX = (int)floorf((view.x + view.width + ASTEROID_CULL_REACH) / state->worldWidth);
+    int firstLapY = (int)floorf((view.y - ASTEROID_CULL_REACH) / state->worldHeight);
+    int lastLapY = (int)floorf((view.y + view.height + ASTEROID_CULL_REACH) / state->worldHeight);
+    
+    for (int lapY = firstLapY; lapY <= lastLapY; lapY++) {
+        for (int lapX = firstLapX; lapX <= lastLapX; lapX++) {
+            Vector2 shift = {lapX * state->worldWidth - view.x, lapY * state->worldHeight - view.y};
+            RasterizePlayfield(state, framebuffer, shift);
+        }
+    }
+}
+
+static void RasterizeBatchJob(void* context, int index) {
+    RasterBatch* batch = context;
+    RasterizeGameState(batch->states[index], &batch->framebuffers[index]);
+}
+
+void RasterizeGameStates(JobPool* pool, const GameState* const* states, SoftFramebuffer* framebuffers, int count) {
+    RasterBatch batch = {states, framebuffers};
+    RunJobs(pool, RasterizeBatchJob, &batch, count);
+}
\ No newline at end of file
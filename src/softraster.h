@@ -0,0 +1,34 @@
+#ifndef SOFTRASTER_H
+#define SOFTRASTER_H
+
+#include "game.h"
+#include "jobs.h"
+
+// 8-bit CPU rasterizer for the same vector geometry DrawGame() emits, for
+// headless observation frames and golden-image tests without a GL context
+
+#define SOFT_FRAMEBUFFER_ALIGNMENT 16
+
+typedef struct {
+    unsigned char* pixels;
+    int width;
+    int height;
+    int stride;
+} SoftFramebuffer;
+
+SoftFramebuffer CreateSoftFramebuffer(int width, int height);
+void DestroySoftFramebuffer(SoftFramebuffer* framebuffer);
+
+// For framebuffers in caller-owned memory of GetSoftFramebufferBytes() bytes,
+// aligned to SOFT_FRAMEBUFFER_ALIGNMENT; these are never destroyed
+size_t GetSoftFramebufferBytes(int width, int height);
+SoftFramebuffer InitSoftFramebuffer(int width, int height, unsigned char* pixels);
+
+void ClearSoftFramebuffer(SoftFramebuffer* framebuffer, unsigned char value);
+void SoftDrawLine(SoftFramebuffer* framebuffer, Vector2 from, Vector2 to, unsigned char value);
+void SoftFillCircle(SoftFramebuffer* framebuffer, Vector2 center, float radius, unsigned char value);
+
+void RasterizeGameState(const GameState* state, SoftFramebuffer* framebuffer);
+void RasterizeGameStates(JobPool* pool, const GameState* const* states, SoftFramebuffer* framebuffers, int count);
+
+#endif
\ No newline at end of file
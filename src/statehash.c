@@ -0,0 +1,227 @@
+#include "statehash.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+// wyhash-style constants: odd, with well spread bits
+#define HASH_KEY_0 0xA0761D6478BD642Full
+#define HASH_KEY_1 0xE7037ED1A0B428DBull
+#define HASH_KEY_2 0x8EBC6AF09C88C6E3ull
+#define HASH_KEY_3 0x589965CC75374CC3ull
+
+// Folded 64x64->128 multiply. The portable path computes the same product
+// so digests agree between desktop and browser builds.
+static inline uint64_t Mix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    uint64_t aLow = (uint32_t)a, aHigh = a >> 32;
+    uint64_t bLow = (uint32_t)b, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow;
+    uint64_t lowHigh = aLow * bHigh;
+    uint64_t highLow = aHigh * bLow;
+    uint64_t highHigh = aHigh * bHigh;
+    uint64_t middle = (lowLow >> 32) + (uint32_t)lowHigh + (uint32_t)highLow;
+    uint64_t low = (middle << 32) | (uint32_t)lowLow;
+    uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+static inline uint64_t Pack(float low, float high) {
+    uint32_t lowBits, highBits;
+    memcpy(&lowBits, &low, sizeof(lowBits));
+    memcpy(&highBits, &high, sizeof(highBits));
+    return (uint64_t)highBits << 32 | lowBits;
+}
+
+static inline uint64_t PackInts(int32_t low, int32_t high) {
+    return (uint64_t)(uint32_t)high << 32 | (uint32_t)low;
+}
+
+// Two independent multiplies per slot; the low bit is forced so an active
+// slot never hashes to the empty value
+static inline uint64_t HashSlot(uint64_t a, uint64_t b, uint64_t c, uint64_t d, int slot) {
+    uint64_t key = (uint64_t)slot * HASH_KEY_3;
+    return (Mix(a ^ HASH_KEY_0, b ^ HASH_KEY_1 ^ key) + Mix(c ^ HASH_KEY_2, d ^ key)) | 1;
+}
+
+// Chained for the handful of words hashed every tick
+static uint64_t HashWords(const uint64_t* words, int count) {
+    uint64_t hash = HASH_KEY_3;
+    for (int i = 0; i < count; i++) {
+        hash = Mix(hash ^ words[i] ^ HASH_KEY_0, (uint64_t)i ^ HASH_KEY_1);
+    }
+    return hash;
+}
+
+uint64_t HashAsteroidSlot(const Asteroid* asteroid, int slot) {
+    if (!asteroid->isActive) return 0;
+    return HashSlot(Pack(asteroid->position.x, asteroid->position.y),
+                    Pack(asteroid->velocity.x, asteroid->velocity.y),
+                    Pack(asteroid->rotation, asteroid->rotationSpeed),
+                    Pack(asteroid->radius, 0) ^ PackInts(0, asteroid->shapeIndex << 8 | asteroid->size),
+                    slot);
+}
+
+uint64_t HashBulletSlot(const Bullet* bullet, int slot) {
+    if (!bullet->isActive) return 0;
+    return HashSlot(Pack(bullet->position.x, bullet->position.y),
+                    Pack(bullet->velocity.x, bullet->velocity.y),
+                    Pack(bullet->lifetime, 0),
+                    bullet->fromPlayer,
+                    slot);
+}
+
+uint64_t HashUFOSlot(const UFO* ufo, int slot) {
+    if (!ufo->isActive) return 0;
+    return HashSlot(Pack(ufo->position.x, ufo->position.y),
+                    Pack(ufo->velocity.x, ufo->velocity.y),
+                    PackInts(ufo->type, ufo->direction),
+                    0,
+                    slot);
+}
+
+static uint64_t HashShip(const Spaceship* ship) {
+    uint64_t words[] = {
+        Pack(ship->position.x, ship->position.y),
+        Pack(ship->velocity.x, ship->velocity.y),
+        Pack(ship->rotation, ship->rotationSpeed),
+        PackInts(ship->lives, ship->isInvulnerable << 2 | ship->isAlive << 1 | ship->isThrusting)
+    };
+    return HashWords(words, sizeof(words) / sizeof(words[0]));
+}
+
+// Each timer by when it is due, or zero while idle
+static uint64_t HashTimers(const TimerWheel* wheel) {
+    uint64_t words[TIMER_COUNT + 1];
+    words[0] = Pack(wheel->carry, 0) ^ PackInts(0, (int32_t)wheel->now);
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        words[i + 1] = IsTimerPending(wheel, i) ? wheel->timers[i].expires : 0;
+    }
+    return HashWords(words, TIMER_COUNT + 1);
+}
+
+// Everything the rules read besides entities; the high score and menu flags
+// come from outside the simulation and are left out
+static uint64_t HashGlobals(const GameState* state) {
+    uint64_t words[] = {
+        PackInts(state->state, state->level),
+        PackInts(state->score, state->asteroidCount),
+        PackInts((int32_t)state->tick, state->levelSet),
+        Pack(state->nextUFOSpawn, state->playTime),
+        HashTimers(&state->timers),
+        Pack(state->camera.x, state->camera.y),
+        state->seed,
+        GetRandomState()
+    };
+    return HashWords(words, sizeof(words) / sizeof(words[0]));
+}
+
+bool InitStateHasher(StateHasher* hasher, int maxAsteroids) {
+    memset(hasher, 0, sizeof(*hasher));
+    hasher->asteroids = calloc(maxAsteroids, sizeof(uint64_t));
+    if (!hasher->asteroids) return false;
+    hasher->maxAsteroids = maxAsteroids;
+    return true;
+}
+
+void FreeStateHasher(StateHasher* hasher) {
+    free(hasher->asteroids);
+    memset(hasher, 0, sizeof(*hasher));
+}
+
+int GetStateHashPeriod(int maxAsteroids) {
+    return (maxAsteroids + STATE_HASH_WINDOW - 1) / STATE_HASH_WINDOW;
+}
+
+void GetStateHashWindow(const GameState* state, uint32_t tick, int* first, int* count) {
+    *first = (int)(tick % (uint32_t)GetStateHashPeriod(state->maxAsteroids)) * STATE_HASH_WINDOW;
+    *count = state->maxAsteroids - *first;
+    if (*count > STATE_HASH_WINDOW) *count = STATE_HASH_WINDOW;
+}
+
+#define PATCH_SLOTS(cache, items, count, hashSlot, sum)                       \
+    do {                                                                      \
+        for (int i = 0; i < (count); i++) {                                   \
+            if (!(items)[i].isActive && (cache)[i] == 0) continue;            \
+            uint64_t hash = hashSlot(&(items)[i], i);                         \
+            (sum) += hash - (cache)[i];                                       \
+            (cache)[i] = hash;                                                \
+        }                                                                     \
+    } while (0)
+
+// The state must have no more asteroid slots than the hasher was made for
+const StateDigest* UpdateStateHasher(StateHasher* hasher, const GameState* state) {
+    uint64_t* groups = hasher->digest.groups;
+    int first, count;
+    GetStateHashWindow(state, state->tick, &first, &count);
+    
+    groups[STATE_HASH_GLOBALS] = HashGlobals(state);
+    groups[STATE_HASH_SHIP] = HashShip(&state->ship);
+    PATCH_SLOTS(hasher->bullets, state->bullets, MAX_BULLETS, HashBulletSlot, groups[STATE_HASH_BULLETS]);
+    PATCH_SLOTS(hasher->ufos, state->ufos, MAX_UFOS, HashUFOSlot, groups[STATE_HASH_UFOS]);
+    
+    for (int i = first; i < first + count; i++) {
+        uint64_t hash = HashAsteroidSlot(&state->asteroids[i], i);
+        uint64_t change = hash - hasher->asteroids[i];
+        groups[STATE_HASH_ASTEROIDS] += change;
+        hasher->digest.asteroidSlots += (uint64_t)(i + 1) * change;
+        hasher->asteroids[i] = hash;
+    }
+    
+    return &hasher->digest;
+}
+
+void ResetStateHasher(StateHasher* hasher, const GameState* state) {
+    memset(&hasher->digest, 0, sizeof(hasher->digest));
+    memset(hasher->bullets, 0, sizeof(hasher->bullets));
+    memset(hasher->ufos, 0, sizeof(hasher->ufos));
+    
+    uint64_t sum = 0, weighted = 0;
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        hasher->asteroids[i] = HashAsteroidSlot(&state->asteroids[i], i);
+        sum += hasher->asteroids[i];
+        weighted += (uint64_t)(i + 1) * hasher->asteroids[i];
+    }
+    hasher->digest.groups[STATE_HASH_ASTEROIDS] = sum;
+    hasher->digest.asteroidSlots = weighted;
+    UpdateStateHasher(hasher, state);
+}
+
+// Solves (slot + 1) * d = w modulo 2^64. Slot hashes are odd, so d is even:
+// both sides lose d's trailing zeros, then the odd part of d is inverted.
+int LocateAsteroidSlot(const StateDigest* expected, const StateDigest* actual, int maxAsteroids) {
+    uint64_t d = expected->groups[STATE_HASH_ASTEROIDS] - actual->groups[STATE_HASH_ASTEROIDS];
+    uint64_t w = expected->asteroidSlots - actual->asteroidSlots;
+    if (d == 0) return -1;
+    
+    int zeros = 0;
+    while (!((d >> zeros) & 1)) zeros++;
+    if ((w & ((1ull << zeros) - 1)) != 0 || 64 - zeros < 32) return -1;
+    
+    // Newton's iteration doubles the correct low bits from the 3 any odd number starts with
+    uint64_t odd = d >> zeros;
+    uint64_t inverse = odd;
+    for (int i = 0; i < 5; i++) inverse *= 2 - odd * inverse;
+    
+    uint64_t index = ((w >> zeros) * inverse) & ((1ull << (64 - zeros)) - 1);
+    if (index < 1 || index > (uint64_t)maxAsteroids || index * d != w) return -1;
+    return (int)index - 1;
+}
+
+uint64_t GetStateDigestHash(const StateDigest* digest) {
+    return HashWords(digest->groups, STATE_HASH_GROUP_COUNT);
+}
+
+const char* GetStateHashGroupName(StateHashGroup group) {
+    static const char* names[STATE_HASH_GROUP_COUNT] = {
+        [STATE_HASH_GLOBALS] = "globals",
+        [STATE_HASH_SHIP] = "ship",
+        [STATE_HASH_BULLETS] = "bullets",
+        [STATE_HASH_UFOS] = "ufos",
+        [STATE_HASH_ASTEROIDS] = "asteroids"
+    };
+    return (group >= 0 && group < STATE_HASH_GROUP_COUNT) ? names[group] : "unknown";
+}
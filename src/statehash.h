@@ -0,0 +1,71 @@
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include "game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-tick digests of the simulation for desync and regression hunting.
+// Every entity slot hashes to 64 bits and a group's digest is the sum of its
+// slots' cached hashes, so a tick rehashes only some slots and patches the
+// sum. Bullet and UFO slots are refreshed every tick, except empty slots that
+// were already empty. Asteroid slots are refreshed a window at a time, chosen
+// by the tick, so swarm games pay for STATE_HASH_WINDOW slots per tick and
+// every slot is checked within GetStateHashPeriod() ticks. Groups are kept
+// apart so a mismatch already says which kind of entity diverged.
+//
+// Asteroids also keep a second sum with each slot's hash weighted by its
+// index. When one slot diverges, both sums change, by d and (slot + 1) * d,
+// so the slot can be solved for without hashing anything more.
+
+#define STATE_HASH_WINDOW 64
+
+typedef enum {
+    STATE_HASH_GLOBALS,
+    STATE_HASH_SHIP,
+    STATE_HASH_BULLETS,
+    STATE_HASH_UFOS,
+    STATE_HASH_ASTEROIDS,
+    STATE_HASH_GROUP_COUNT
+} StateHashGroup;
+
+typedef struct {
+    uint64_t groups[STATE_HASH_GROUP_COUNT];
+    uint64_t asteroidSlots;
+} StateDigest;
+
+// Caches the last hash of every slot; empty slots are cached as zero
+typedef struct {
+    StateDigest digest;
+    uint64_t bullets[MAX_BULLETS];
+    uint64_t ufos[MAX_UFOS];
+    uint64_t* asteroids;
+    int maxAsteroids;
+} StateHasher;
+
+bool InitStateHasher(StateHasher* hasher, int maxAsteroids);
+void FreeStateHasher(StateHasher* hasher);
+
+// Reset hashes every slot; updates then follow the state tick by tick.
+// Globals include the calling thread's game random state, so hash on the
+// thread that steps the game.
+void ResetStateHasher(StateHasher* hasher, const GameState* state);
+const StateDigest* UpdateStateHasher(StateHasher* hasher, const GameState* state);
+
+// The asteroid slots a tick refreshes, and how many ticks it takes to refresh them all
+void GetStateHashWindow(const GameState* state, uint32_t tick, int* first, int* count);
+int GetStateHashPeriod(int maxAsteroids);
+
+// The one asteroid slot whose hash explains the difference, or -1 when no
+// single slot below maxAsteroids does
+int LocateAsteroidSlot(const StateDigest* expected, const StateDigest* actual, int maxAsteroids);
+
+uint64_t GetStateDigestHash(const StateDigest* digest);
+const char* GetStateHashGroupName(StateHashGroup group);
+
+// Slot hashes; zero for an empty slot
+uint64_t HashAsteroidSlot(const Asteroid* asteroid, int slot);
+uint64_t HashBulletSlot(const Bullet* bullet, int slot);
+uint64_t HashUFOSlot(const UFO* ufo, int slot);
+
+#endif
@@ -0,0 +1,265 @@
+#define _POSIX_C_SOURCE 200809L
+#include "telemetry.h"
+#include "utils.h"
+#include "raylib.h"
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(PLATFORM_WEB)
+    #include <pthread.h>
+#endif
+
+// The web build has no flusher thread; the main loop drains a smaller ring instead
+#if defined(PLATFORM_WEB)
+    #define TELEMETRY_CAPACITY 4096
+#else
+    #define TELEMETRY_CAPACITY 16384
+#endif
+
+#define TELEMETRY_BATCH_SIZE 4096
+#define TELEMETRY_STAGE_SIZE 32
+#define TELEMETRY_FLUSH_INTERVAL 0.25
+
+// Each slot's sequence says whose turn it is: equal to the position when a
+// producer may fill it, position + 1 once it holds an event for the consumer
+typedef struct {
+    atomic_size_t sequence;
+    TelemetryEvent event;
+} TelemetrySlot;
+
+typedef struct {
+    alignas(64) atomic_size_t head;
+    alignas(64) size_t tail;
+    alignas(64) atomic_uint_fast64_t dropped;
+    atomic_uint frame;
+    atomic_bool ready;
+    
+    FILE* file;
+    atomic_uint_fast64_t written;
+    double nextFlush;
+    TelemetryEvent batch[TELEMETRY_BATCH_SIZE];
+    unsigned char columns[TELEMETRY_BATCH_SIZE * sizeof(TelemetryEvent)];
+
+#if !defined(PLATFORM_WEB)
+    pthread_t flusher;
+    atomic_bool quit;
+#endif
+
+    TelemetrySlot slots[TELEMETRY_CAPACITY];
+} Telemetry;
+
+// Events are staged per thread and published a run at a time, so the one
+// atomic claim on the shared ring is paid once per TELEMETRY_STAGE_SIZE events
+typedef struct {
+    TelemetryEvent events[TELEMETRY_STAGE_SIZE];
+    int count;
+} TelemetryStage;
+
+static Telemetry telemetry = { 0 };
+static thread_local TelemetryStage stage = { 0 };
+
+// Called by the frame thread once per frame, which also publishes its staged events
+void SetTelemetryFrame(uint32_t frame) {
+    atomic_store_explicit(&telemetry.frame, frame, memory_order_relaxed);
+    PublishTelemetry();
+}
+
+// Claims a run of slots with one CAS. The consumer frees slots in order, so
+// if the last slot of the run is free for this lap, every slot before it is too.
+void PublishTelemetry(void) {
+    int count = stage.count;
+    if (count == 0) return;
+    stage.count = 0;
+    
+    size_t position = atomic_load_explicit(&telemetry.head, memory_order_relaxed);
+    for (;;) {
+        size_t last = position + count - 1;
+        size_t sequence = atomic_load_explicit(&telemetry.slots[last % TELEMETRY_CAPACITY].sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)last;
+        
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&telemetry.head, &position, position + count,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            atomic_fetch_add_explicit(&telemetry.dropped, count, memory_order_relaxed);
+            return;
+        } else {
+            position = atomic_load_explicit(&telemetry.head, memory_order_relaxed);
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        TelemetrySlot* slot = &telemetry.slots[(position + i) % TELEMETRY_CAPACITY];
+        slot->event = stage.events[i];
+        atomic_store_explicit(&slot->sequence, position + i + 1, memory_order_release);
+    }
+}
+
+// Hot path: a plain store into the thread's stage. Simulation threads with
+// effects disabled (lookahead rollouts) stay silent.
+void EmitTelemetry(TelemetryEventType type, int detail, float x, float y, float value) {
+    if (!atomic_load_explicit(&telemetry.ready, memory_order_relaxed) || !AreEffectsEnabled()) return;
+    
+    stage.events[stage.count++] = (TelemetryEvent){
+        .frame = atomic_load_explicit(&telemetry.frame, memory_order_relaxed),
+        .type = (uint16_t)type,
+        .detail = (uint16_t)detail,
+        .x = x,
+        .y = y,
+        .value = value
+    };
+    if (stage.count == TELEMETRY_STAGE_SIZE) {
+        PublishTelemetry();
+    }
+}
+
+static int DrainEvents(void) {
+    int count = 0;
+    
+    while (count < TELEMETRY_BATCH_SIZE) {
+        TelemetrySlot* slot = &telemetry.slots[telemetry.tail % TELEMETRY_CAPACITY];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (sequence != telemetry.tail + 1) break;
+        
+        telemetry.batch[count++] = slot->event;
+        atomic_store_explicit(&slot->sequence, telemetry.tail + TELEMETRY_CAPACITY, memory_order_release);
+        telemetry.tail++;
+    }
+    
+    return count;
+}
+
+#define PACK_COLUMN(field)                                                    \
+    do {                                                                      \
+        for (int i = 0; i < count; i++) {                                     \
+            memcpy(out, &telemetry.batch[i].field, sizeof(telemetry.batch[i].field)); \
+            out += sizeof(telemetry.batch[i].field);                          \
+        }                                                                     \
+    } while (0)
+
+static void WriteBatch(int count) {
+    unsigned char* out = telemetry.columns;
+    PACK_COLUMN(frame);
+    PACK_COLUMN(type);
+    PACK_COLUMN(detail);
+    PACK_COLUMN(x);
+    PACK_COLUMN(y);
+    PACK_COLUMN(value);
+    
+    int compressedSize = 0;
+    unsigned char* compressed = CompressData(telemetry.columns, (int)(out - telemetry.columns), &compressedSize);
+    if (!compressed) return;
+    
+    TelemetryBatchHeader header = {
+        .eventCount = (uint32_t)count,
+        .compressedSize = (uint32_t)compressedSize,
+        .droppedTotal = atomic_load_explicit(&telemetry.dropped, memory_order_relaxed)
+    };
+    fwrite(&header, sizeof(header), 1, telemetry.file);
+    fwrite(compressed, 1, compressedSize, telemetry.file);
+    MemFree(compressed);
+    
+    atomic_fetch_add_explicit(&telemetry.written, count, memory_order_relaxed);
+}
+
+static void FlushTelemetry(void) {
+    int count;
+    while ((count = DrainEvents()) > 0) {
+        WriteBatch(count);
+    }
+    fflush(telemetry.file);
+}
+
+#if !defined(PLATFORM_WEB)
+static void* TelemetryFlusher(void* arg) {
+    (void)arg;
+    struct timespec interval = { 0, (long)(TELEMETRY_FLUSH_INTERVAL * 1e9) };
+    
+    while (!atomic_load_explicit(&telemetry.quit, memory_order_acquire)) {
+        FlushTelemetry();
+        nanosleep(&interval, nullptr);
+    }
+    
+    FlushTelemetry();
+    return nullptr;
+}
+#endif
+
+bool StartTelemetry(const char* path) {
+    if (atomic_load(&telemetry.ready)) return true;
+    
+    telemetry.file = fopen(path, "wb");
+    if (!telemetry.file) {
+        fprintf(stderr, "Failed to open telemetry file: %s\n", path);
+        return false;
+    }
+    
+    TelemetryFileHeader header = { TELEMETRY_MAGIC, TELEMETRY_VERSION, sizeof(TelemetryEvent), 0 };
+    fwrite(&header, sizeof(header), 1, telemetry.file);
+    
+    for (size_t i = 0; i < TELEMETRY_CAPACITY; i++) {
+        atomic_init(&telemetry.slots[i].sequence, i);
+    }
+    atomic_init(&telemetry.head, 0);
+    telemetry.tail = 0;
+    atomic_init(&telemetry.written, 0);
+    atomic_init(&telemetry.dropped, 0);
+
+#if !defined(PLATFORM_WEB)
+    atomic_init(&telemetry.quit, false);
+    if (pthread_create(&telemetry.flusher, nullptr, TelemetryFlusher, nullptr) != 0) {
+        fclose(telemetry.file);
+        telemetry.file = nullptr;
+        return false;
+    }
+#endif
+
+    atomic_store(&telemetry.ready, true);
+    return true;
+}
+
+void StopTelemetry(void) {
+    if (!atomic_load(&telemetry.ready)) return;
+    PublishTelemetry();
+    atomic_store(&telemetry.ready, false);
+
+#if defined(PLATFORM_WEB)
+    FlushTelemetry();
+#else
+    atomic_store_explicit(&telemetry.quit, true, memory_order_release);
+    pthread_join(telemetry.flusher, nullptr);
+#endif
+
+    uint64_t dropped = atomic_load(&telemetry.dropped);
+    if (dropped > 0) {
+        fprintf(stderr, "Telemetry dropped %llu events\n", (unsigned long long)dropped);
+    }
+    
+    fclose(telemetry.file);
+    telemetry.file = nullptr;
+}
+
+// Desktop flushes on its own thread; the web build drains from the main loop
+void UpdateTelemetry(double now) {
+#if defined(PLATFORM_WEB)
+    if (!atomic_load_explicit(&telemetry.ready, memory_order_relaxed) || now < telemetry.nextFlush) return;
+    telemetry.nextFlush = now + TELEMETRY_FLUSH_INTERVAL;
+    FlushTelemetry();
+#else
+    (void)now;
+#endif
+}
+
+uint64_t GetTelemetryDroppedCount(void) {
+    return atomic_load_explicit(&telemetry.dropped, memory_order_relaxed);
+}
+
+uint64_t GetTelemetryWrittenCount(void) {
+    return atomic_load_explicit(&telemetry.written, memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Gameplay event stream. Any thread can emit; events are staged per thread
+// and published into a fixed lock-free ring, which a background flusher
+// drains into compressed batches on disk. When the ring is full, events are
+// dropped and counted rather than blocking. Threads other than the frame
+// thread publish when their stage fills or when they call PublishTelemetry().
+//
+// File layout: a TelemetryFileHeader, then batches of a TelemetryBatchHeader
+// followed by DEFLATE data. Each batch decompresses to the batch's events
+// stored column by column (every frame, then every type, and so on), which
+// packs far better than whole structs.
+
+#define TELEMETRY_MAGIC 0x4C455441u  // "ATEL"
+#define TELEMETRY_VERSION 1
+
+typedef enum {
+    TELEMETRY_FRAME,
+    TELEMETRY_BULLET_FIRED,
+    TELEMETRY_ASTEROID_HIT,
+    TELEMETRY_ASTEROID_SPLIT,
+    TELEMETRY_UFO_SPAWNED,
+    TELEMETRY_UFO_DESTROYED,
+    TELEMETRY_SHIP_DESTROYED,
+    TELEMETRY_SHIP_RESPAWNED,
+    TELEMETRY_GAME_OVER,
+    TELEMETRY_INPUT_LATENCY,
+    TELEMETRY_STARTUP
+} TelemetryEventType;
+
+// Detail for TELEMETRY_SHIP_DESTROYED
+typedef enum {
+    TELEMETRY_CAUSE_ASTEROID,
+    TELEMETRY_CAUSE_BULLET,
+    TELEMETRY_CAUSE_UFO
+} TelemetryDeathCause;
+
+// Detail for TELEMETRY_STARTUP; the value is seconds since launch, or for
+// audio the time its background startup took
+typedef enum {
+    TELEMETRY_STARTUP_WINDOW,
+    TELEMETRY_STARTUP_FIRST_FRAME,
+    TELEMETRY_STARTUP_AUDIO
+} TelemetryStartupPhase;
+
+typedef struct {
+    uint32_t frame;
+    uint16_t type;
+    uint16_t detail;
+    float x;
+    float y;
+    float value;
+} TelemetryEvent;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t eventSize;
+    uint32_t reserved;
+} TelemetryFileHeader;
+
+typedef struct {
+    uint32_t eventCount;
+    uint32_t compressedSize;
+    uint64_t droppedTotal;
+} TelemetryBatchHeader;
+
+bool StartTelemetry(const char* path);
+void StopTelemetry(void);
+void UpdateTelemetry(double now);
+
+void SetTelemetryFrame(uint32_t frame);
+void EmitTelemetry(TelemetryEventType type, int detail, float x, float y, float value);
+void PublishTelemetry(void);
+
+uint64_t GetTelemetryDroppedCount(void);
+uint64_t GetTelemetryWrittenCount(void);
+
+#endif
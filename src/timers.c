@@ -0,0 +1,143 @@
+#include "timers.h"
+#include <math.h>
+
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+
+void InitTimerWheel(TimerWheel* wheel) {
+    wheel->now = 0;
+    wheel->carry = 0;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        wheel->occupied[level] = 0;
+    }
+    for (int i = 0; i < TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS; i++) {
+        wheel->heads[i] = TIMER_NONE;
+    }
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        wheel->timers[i] = (Timer){ .expires = 0, .next = TIMER_NONE, .prev = TIMER_NONE, .slot = TIMER_NONE };
+    }
+}
+
+// Files a timer by how far off it is: the lowest level whose span reaches it
+static void InsertTimer(TimerWheel* wheel, int timer) {
+    Timer* entry = &wheel->timers[timer];
+    uint32_t delta = entry->expires - wheel->now;
+    
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >> (TIMER_WHEEL_BITS * (level + 1)) != 0) {
+        level++;
+    }
+    int index = (int)(entry->expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    int slot = level * TIMER_WHEEL_SLOTS + index;
+    
+    entry->slot = (int16_t)slot;
+    entry->prev = TIMER_NONE;
+    entry->next = wheel->heads[slot];
+    if (entry->next != TIMER_NONE) {
+        wheel->timers[entry->next].prev = (int16_t)timer;
+    }
+    wheel->heads[slot] = (int16_t)timer;
+    wheel->occupied[level] |= 1u << index;
+}
+
+static void UnlinkTimer(TimerWheel* wheel, int timer) {
+    Timer* entry = &wheel->timers[timer];
+    int slot = entry->slot;
+    
+    if (entry->prev != TIMER_NONE) {
+        wheel->timers[entry->prev].next = entry->next;
+    } else {
+        wheel->heads[slot] = entry->next;
+    }
+    if (entry->next != TIMER_NONE) {
+        wheel->timers[entry->next].prev = entry->prev;
+    }
+    if (wheel->heads[slot] == TIMER_NONE) {
+        wheel->occupied[slot / TIMER_WHEEL_SLOTS] &= ~(1u << (slot & TIMER_WHEEL_MASK));
+    }
+    
+    entry->next = TIMER_NONE;
+    entry->prev = TIMER_NONE;
+    entry->slot = TIMER_NONE;
+}
+
+void ScheduleTimer(TimerWheel* wheel, int timer, float seconds) {
+    if (wheel->timers[timer].slot != TIMER_NONE) {
+        UnlinkTimer(wheel, timer);
+    }
+    
+    float ticks = roundf(seconds * TIMER_TICKS_PER_SECOND);
+    uint32_t delay = ticks < 1.0f ? 1 : ticks > (float)TIMER_MAX_TICKS ? TIMER_MAX_TICKS : (uint32_t)ticks;
+    wheel->timers[timer].expires = wheel->now + delay;
+    InsertTimer(wheel, timer);
+}
+
+void CancelTimer(TimerWheel* wheel, int timer) {
+    if (wheel->timers[timer].slot != TIMER_NONE) {
+        UnlinkTimer(wheel, timer);
+    }
+}
+
+bool IsTimerPending(const TimerWheel* wheel, int timer) {
+    return wheel->timers[timer].slot != TIMER_NONE;
+}
+
+float GetTimerRemaining(const TimerWheel* wheel, int timer) {
+    if (!IsTimerPending(wheel, timer)) return 0.0f;
+    float ticks = (float)(wheel->timers[timer].expires - wheel->now) - wheel->carry;
+    return ticks / TIMER_TICKS_PER_SECOND;
+}
+
+// Reached when the clock's low bits roll over: each level whose slot index
+// just changed hands its slot's timers down, highest level first, so a timer
+// can fall through several levels in one step
+static void CascadeTimers(TimerWheel* wheel) {
+    int top = 1;
+    while (top < TIMER_WHEEL_LEVELS - 1 && ((wheel->now >> (TIMER_WHEEL_BITS * top)) & TIMER_WHEEL_MASK) == 0) {
+        top++;
+    }
+    
+    for (int level = top; level >= 1; level--) {
+        int index = (int)(wheel->now >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+        int slot = level * TIMER_WHEEL_SLOTS + index;
+        while (wheel->heads[slot] != TIMER_NONE) {
+            int timer = wheel->heads[slot];
+            UnlinkTimer(wheel, timer);
+            InsertTimer(wheel, timer);
+        }
+    }
+}
+
+// Level 0 only ever holds timers due within the next TIMER_WHEEL_SLOTS ticks,
+// so a slot's timers are all due at the tick that reaches it. The clock skips
+// straight to the next occupied slot or roll-over instead of visiting every tick.
+void AdvanceTimers(TimerWheel* wheel, float seconds, TimerCallback callback, void* context) {
+    wheel->carry += seconds * TIMER_TICKS_PER_SECOND;
+    uint32_t steps = (uint32_t)wheel->carry;
+    wheel->carry -= (float)steps;
+    uint32_t target = wheel->now + steps;
+    
+    while (wheel->now != target) {
+        uint32_t next = wheel->now + 1;
+        
+        if ((next & TIMER_WHEEL_MASK) != 0) {
+            uint32_t blockEnd = next | TIMER_WHEEL_MASK;
+            uint32_t limit = (target - next < blockEnd - next) ? target : blockEnd;
+            uint32_t pending = wheel->occupied[0] >> (next & TIMER_WHEEL_MASK);
+            if (pending == 0 || next + (uint32_t)__builtin_ctz(pending) > limit) {
+                wheel->now = limit;
+                continue;
+            }
+            wheel->now = next + (uint32_t)__builtin_ctz(pending);
+        } else {
+            wheel->now = next;
+            CascadeTimers(wheel);
+        }
+        
+        int slot = (int)(wheel->now & TIMER_WHEEL_MASK);
+        while (wheel->heads[slot] != TIMER_NONE) {
+            int timer = wheel->heads[slot];
+            UnlinkTimer(wheel, timer);
+            callback(context, timer);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#include "entities.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Gameplay timers on a hierarchical timing wheel. The wheel counts
+// milliseconds of play time; a tick advances it by the tick's delta and fires
+// only the timers that came due, so a pending timer costs nothing until then.
+// Level 0 holds timers due within TIMER_WHEEL_SLOTS ms, one slot per ms, and
+// each level above covers TIMER_WHEEL_SLOTS times the span of the one below.
+// Its slots are moved down a level as the clock reaches them. Scheduling and
+// cancelling unlink from a slot list and are O(1).
+//
+// Every timer has a fixed id, so the wheel is one flat block of indices that
+// copies with the game state and needs no allocation.
+
+#define TIMER_TICKS_PER_SECOND 1000
+#define TIMER_WHEEL_BITS 5
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_MAX_TICKS ((1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1)
+#define TIMER_NONE -1
+
+typedef enum {
+    TIMER_FIRE,
+    TIMER_RESPAWN,
+    TIMER_NEXT_LEVEL,
+    TIMER_UFO_SPAWN,
+    TIMER_SHIP_INVULNERABLE,
+    TIMER_UFO_SHOOT,
+    TIMER_UFO_STEER = TIMER_UFO_SHOOT + MAX_UFOS,
+    TIMER_COUNT = TIMER_UFO_STEER + MAX_UFOS
+} TimerId;
+
+typedef struct {
+    uint32_t expires;
+    int16_t next;
+    int16_t prev;
+    int16_t slot;
+} Timer;
+
+typedef struct {
+    uint32_t now;
+    float carry;
+    uint32_t occupied[TIMER_WHEEL_LEVELS];
+    int16_t heads[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];
+    Timer timers[TIMER_COUNT];
+} TimerWheel;
+
+// Called with each timer as it expires; the timer is already idle, so the
+// callback may schedule it again. A timer rescheduled from its own callback
+// counts from its expiry, keeping periodic timers exact.
+typedef void (*TimerCallback)(void* context, int timer);
+
+void InitTimerWheel(TimerWheel* wheel);
+
+// Delays round to the nearest tick, at least one, and are capped at TIMER_MAX_TICKS;
+// scheduling a pending timer moves it
+void ScheduleTimer(TimerWheel* wheel, int timer, float seconds);
+void CancelTimer(TimerWheel* wheel, int timer);
+bool IsTimerPending(const TimerWheel* wheel, int timer);
+float GetTimerRemaining(const TimerWheel* wheel, int timer);
+
+void AdvanceTimers(TimerWheel* wheel, float seconds, TimerCallback callback, void* context);
+
+#endif
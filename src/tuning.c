@@ -0,0 +1,197 @@
+#define _POSIX_C_SOURCE 200809L
+#include "tuning.h"
+#include "entities.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define TUNING_POLL_INTERVAL 0.5
+
+static const TuningTable defaultTuning = {
+    .shipThrustPower = SPACESHIP_THRUST_POWER,
+    .shipRotationSpeed = SPACESHIP_ROTATION_SPEED,
+    .shipMaxSpeed = SPACESHIP_MAX_SPEED,
+    .shipDrag = SPACESHIP_DRAG,
+    .shipInvulnerableTime = SPACESHIP_INVULNERABLE_TIME,
+    
+    .bulletSpeed = BULLET_SPEED,
+    .bulletLifetime = BULLET_LIFETIME,
+    .fireDelay = 0.25f,
+    
+    .asteroidSpeedMin = ASTEROID_SPEED_MIN,
+    .asteroidSpeedMax = ASTEROID_SPEED_MAX,
+    
+    .ufoLargeSpeed = UFO_LARGE_SPEED,
+    .ufoSmallSpeed = UFO_SMALL_SPEED,
+    .ufoShootInterval = UFO_SHOOT_INTERVAL,
+    .ufoBaseSpawnTime = 20.0f,
+    
+    .nextLevelDelay = 2.0f,
+    .respawnDelay = 2.0f
+};
+
+typedef struct {
+    const char* name;
+    size_t offset;
+    float min;
+    float max;
+} TuningLimit;
+
+#define TUNING_LIMIT(field, min) { #field, offsetof(TuningTable, field), min, TUNING_MAX_VALUE }
+
+static const TuningLimit tuningLimits[] = {
+    TUNING_LIMIT(shipThrustPower, 0),
+    TUNING_LIMIT(shipRotationSpeed, 0),
+    TUNING_LIMIT(shipMaxSpeed, 0),
+    { "shipDrag", offsetof(TuningTable, shipDrag), 0, 1 },
+    TUNING_LIMIT(shipInvulnerableTime, 0),
+    TUNING_LIMIT(bulletSpeed, 0),
+    TUNING_LIMIT(bulletLifetime, 0),
+    TUNING_LIMIT(fireDelay, 0),
+    TUNING_LIMIT(asteroidSpeedMin, 0),
+    TUNING_LIMIT(asteroidSpeedMax, 0),
+    TUNING_LIMIT(ufoLargeSpeed, 0),
+    TUNING_LIMIT(ufoSmallSpeed, 0),
+    TUNING_LIMIT(ufoShootInterval, TUNING_MIN_INTERVAL),
+    TUNING_LIMIT(ufoBaseSpawnTime, TUNING_MIN_INTERVAL),
+    TUNING_LIMIT(nextLevelDelay, 0),
+    TUNING_LIMIT(respawnDelay, 0)
+};
+
+const TuningTable* tuning = &defaultTuning;
+
+typedef struct {
+    bool active;
+    char path[512];
+    struct stat fileInfo;
+    double nextPoll;
+} TuningFile;
+
+static TuningFile loaded = { 0 };
+
+// The game reads this copy, never the file, so rewriting the file cannot fault or tear a tick
+static TuningTable loadedTable;
+
+const TuningTable* GetDefaultTuning(void) {
+    return &defaultTuning;
+}
+
+// Callers own the table's lifetime; used by tools that sweep tables in memory
+void SetTuningTable(const TuningTable* table) {
+    tuning = table ? table : &defaultTuning;
+}
+
+// Rejects NaN too, since every comparison with it fails
+const char* CheckTuningTable(const TuningTable* table) {
+    for (size_t i = 0; i < sizeof(tuningLimits) / sizeof(tuningLimits[0]); i++) {
+        const TuningLimit* limit = &tuningLimits[i];
+        float value;
+        memcpy(&value, (const unsigned char*)table + limit->offset, sizeof(value));
+        if (!(value >= limit->min && value <= limit->max)) return limit->name;
+    }
+    if (table->asteroidSpeedMin > table->asteroidSpeedMax) return "asteroidSpeedMin";
+    return nullptr;
+}
+
+uint32_t HashTuningTable(const TuningTable* table) {
+    const unsigned char* bytes = (const unsigned char*)table;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(TuningTable); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static const char* ReadTuningFile(const char* path, TuningTable* table) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return "cannot open file";
+    
+    TuningHeader header;
+    bool read = fread(&header, sizeof(header), 1, file) == 1 &&
+                fread(table, sizeof(TuningTable), 1, file) == 1;
+    fclose(file);
+    
+    if (!read) return "file too short";
+    if (header.magic != TUNING_MAGIC || header.version != TUNING_VERSION || header.size != sizeof(TuningTable)) {
+        return "not a tuning table for this version";
+    }
+    // A file caught mid-write fails here and is picked up again once it changes
+    if (header.checksum != HashTuningTable(table)) return "checksum mismatch";
+    return nullptr;
+}
+
+// A bad file leaves the current values in place
+bool LoadTuningTable(const char* path) {
+    // Stat first: a change made during the read then shows up on the next poll
+    struct stat info = { 0 };
+    stat(path, &info);
+    
+    TuningTable table;
+    const char* problem = ReadTuningFile(path, &table);
+    const char* field = problem ? nullptr : CheckTuningTable(&table);
+    
+    // Remember the file even when it is bad, so a reload reports each change once
+    loaded.active = true;
+    loaded.fileInfo = info;
+    if (loaded.path != path) snprintf(loaded.path, sizeof(loaded.path), "%s", path);
+    
+    if (problem || field) {
+        if (field) {
+            fprintf(stderr, "Failed to load tuning table: %s (%s out of range)\n", path, field);
+        } else {
+            fprintf(stderr, "Failed to load tuning table: %s (%s)\n", path, problem);
+        }
+        return false;
+    }
+    
+    loadedTable = table;
+    tuning = &loadedTable;
+    return true;
+}
+
+// Write to a temporary file and rename it, so running games never read a half-written table
+bool SaveTuningTable(const char* path, const TuningTable* table) {
+    char temporary[520];
+    snprintf(temporary, sizeof(temporary), "%s.tmp", path);
+    
+    FILE* file = fopen(temporary, "wb");
+    if (!file) return false;
+    
+    TuningHeader header = { TUNING_MAGIC, TUNING_VERSION, sizeof(TuningTable), HashTuningTable(table) };
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(table, sizeof(TuningTable), 1, file) == 1;
+    written = (fclose(file) == 0) && written;
+    
+    if (!written || rename(temporary, path) != 0) {
+        remove(temporary);
+        return false;
+    }
+    return true;
+}
+
+void UnloadTuningTable(void) {
+    tuning = &defaultTuning;
+    loaded.active = false;
+}
+
+bool PollTuningReload(double now) {
+#if defined(PLATFORM_WEB)
+    (void)now;
+    return false;
+#else
+    if (!loaded.active || now < loaded.nextPoll) return false;
+    loaded.nextPoll = now + TUNING_POLL_INTERVAL;
+    
+    struct stat info;
+    if (stat(loaded.path, &info) != 0) return false;
+    
+    // SaveTuningTable replaces the file, which changes the inode; other
+    // writers rewrite it in place, which changes the size or time
+    if (info.st_ino == loaded.fileInfo.st_ino && info.st_mtime == loaded.fileInfo.st_mtime &&
+        info.st_size == loaded.fileInfo.st_size) {
+        return false;
+    }
+    return LoadTuningTable(loaded.path);
+#endif
+}
@@ -0,0 +1,70 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Gameplay balance values, read through the `tuning` pointer. A loaded
+// table is checked and copied once per (re)load, so switching parameter sets
+// needs no rebuild and a file rewritten in place is never seen half-written.
+// Collision radii stay compile-time constants in entities.h.
+//
+// File layout: a 16-byte TuningHeader followed by the TuningTable floats,
+// little-endian, exactly as laid out below. The checksum is FNV-1a over the
+// table bytes.
+
+#define TUNING_MAGIC 0x4E555441u  // "ATUN"
+#define TUNING_VERSION 2
+
+// Every value must lie within [0, TUNING_MAX_VALUE], well inside the
+// fixed-point range, and repeating timers need at least TUNING_MIN_INTERVAL
+#define TUNING_MAX_VALUE 10000.0f
+#define TUNING_MIN_INTERVAL 0.01f
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t checksum;
+} TuningHeader;
+
+typedef struct {
+    float shipThrustPower;
+    float shipRotationSpeed;
+    float shipMaxSpeed;
+    float shipDrag;
+    float shipInvulnerableTime;
+    
+    float bulletSpeed;
+    float bulletLifetime;
+    float fireDelay;
+    
+    float asteroidSpeedMin;
+    float asteroidSpeedMax;
+    
+    float ufoLargeSpeed;
+    float ufoSmallSpeed;
+    float ufoShootInterval;
+    float ufoBaseSpawnTime;
+    
+    float nextLevelDelay;
+    float respawnDelay;
+} TuningTable;
+
+extern const TuningTable* tuning;
+
+const TuningTable* GetDefaultTuning(void);
+void SetTuningTable(const TuningTable* table);
+
+// Name of the first out-of-range value, or nullptr when the table is usable
+const char* CheckTuningTable(const TuningTable* table);
+uint32_t HashTuningTable(const TuningTable* table);
+
+bool LoadTuningTable(const char* path);
+bool SaveTuningTable(const char* path, const TuningTable* table);
+void UnloadTuningTable(void);
+
+// Desktop only: reloads the table when the file changes. Returns true on reload.
+bool PollTuningReload(double now);
+
+#endif
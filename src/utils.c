@@ -1,24 +1,84 @@
+#define _POSIX_C_SOURCE 200809L
 #include "utils.h"
-#include <stdlib.h>
 #include <time.h>
 
-static bool randomInitialized = false;
+#if defined(PLATFORM_WEB)
+    #include <malloc.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+static thread_local uint64_t randomState = 0;
+static thread_local bool effectsDisabled = false;
 
 static void EnsureRandomInit(void) {
-    if (!randomInitialized) {
-        srand((unsigned int)time(nullptr));
-        randomInitialized = true;
+    if (randomState == 0) {
+        SeedRandom((uint64_t)time(nullptr));
     }
 }
 
-float RandomFloat(float min, float max) {
+// xorshift64* keeps the stream reproducible on every platform for a given seed
+static uint64_t NextRandom(void) {
+    EnsureRandomInit();
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+    return randomState * 0x2545F4914F6CDD1DULL;
+}
+
+void SeedRandom(uint64_t seed) {
+    // splitmix64 spreads nearby seeds apart and never yields the all-zero state
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    randomState = (z != 0) ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+uint64_t GetRandomState(void) {
     EnsureRandomInit();
-    float scale = rand() / (float)RAND_MAX;
+    return randomState;
+}
+
+void SetRandomState(uint64_t state) {
+    randomState = state;
+}
+
+float RandomFloat(float min, float max) {
+    float scale = (NextRandom() >> 40) * (1.0f / 16777216.0f);
     return min + scale * (max - min);
 }
 
 int RandomInt(int min, int max) {
-    EnsureRandomInit();
-    return min + rand() % (max - min + 1);
+    return min + (int)(NextRandom() % (uint64_t)(max - min + 1));
+}
+
+// Usable without a window, unlike raylib's GetTime()
+double GetMonotonicTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
 }
 
+// Desktop reports the peak resident set; the browser the most the wasm heap's malloc has ever held
+size_t GetPeakMemoryUsage(void) {
+#if defined(PLATFORM_WEB)
+    return (size_t)mallinfo().usmblks;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #if defined(__APPLE__)
+        return (size_t)usage.ru_maxrss;
+    #else
+        return (size_t)usage.ru_maxrss * 1024;
+    #endif
+#endif
+}
+
+void SetEffectsEnabled(bool enabled) {
+    effectsDisabled = !enabled;
+}
+
+bool AreEffectsEnabled(void) {
+    return !effectsDisabled;
+}
@@ -2,8 +2,23 @@
 #define UTILS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 float RandomFloat(float min, float max);
 int RandomInt(int min, int max);
 
+// Gameplay randomness is per thread so headless sessions can be seeded and stepped in parallel
+void SeedRandom(uint64_t seed);
+uint64_t GetRandomState(void);
+void SetRandomState(uint64_t state);
+
+double GetMonotonicTime(void);
+size_t GetPeakMemoryUsage(void);
+
+// Sound, particles and telemetry are shared by the whole process; simulation
+// threads that step throwaway copies of a game switch them off for themselves only
+void SetEffectsEnabled(bool enabled);
+bool AreEffectsEnabled(void);
+
 #endif
\ No newline at end of file
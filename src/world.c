@@ -0,0 +1,350 @@
+#include "world.h"
+#include "collision.h"
+#include "instancing.h"
+#include "particles.h"
+#include "rlgl.h"
+#include <math.h>
+#include <string.h>
+
+// Largest distance from an asteroid's centre to its outline
+#define WORLD_MAX_ASTEROID_REACH (ASTEROID_LARGE_RADIUS * ASTEROID_SHAPE_MAX_SCALE)
+
+// Views into the chunk block that trails the asteroid slots. `pending` is
+// the time each chunk has yet to simulate; a slot's chunk is -1 while it is
+// not filed anywhere.
+typedef struct {
+    int* heads;
+    float* pending;
+    int* next;
+    int* prev;
+    int* chunkOf;
+} ChunkLists;
+
+// Visible asteroids are copied here before drawing; only the render thread draws
+static Asteroid visibleAsteroids[MAX_SWARM_ASTEROIDS];
+
+bool IsOpenWorld(const GameState* state) {
+    return state->chunkColumns > 0;
+}
+
+void GetWorldChunkGrid(float worldWidth, float worldHeight, int* columns, int* rows) {
+    *columns = (int)ceilf(worldWidth / WORLD_CHUNK_SIZE);
+    *rows = (int)ceilf(worldHeight / WORLD_CHUNK_SIZE);
+    if (*columns < 1) *columns = 1;
+    if (*rows < 1) *rows = 1;
+    while (*columns * *rows > WORLD_MAX_CHUNKS) {
+        *columns = (*columns + 1) / 2;
+        *rows = (*rows + 1) / 2;
+    }
+}
+
+size_t GetWorldChunkBytes(int chunkCount, int maxAsteroids) {
+    if (chunkCount == 0) return 0;
+    return (size_t)chunkCount * (sizeof(int) + sizeof(float)) + (size_t)maxAsteroids * 3 * sizeof(int);
+}
+
+// The lists are part of the state's block, so a const state still hands out
+// writable views; only the stepping and tracking functions write through them
+static ChunkLists GetChunkLists(const GameState* state) {
+    int chunkCount = state->chunkColumns * state->chunkRows;
+    unsigned char* base = (unsigned char*)(state->asteroids + state->maxAsteroids);
+    
+    ChunkLists lists;
+    lists.heads = (int*)base;
+    lists.pending = (float*)(lists.heads + chunkCount);
+    lists.next = (int*)(lists.pending + chunkCount);
+    lists.prev = lists.next + state->maxAsteroids;
+    lists.chunkOf = lists.prev + state->maxAsteroids;
+    return lists;
+}
+
+static int WrapIndex(int index, int count) {
+    index %= count;
+    return (index < 0) ? index + count : index;
+}
+
+// How many whole worlds an unwrapped chunk index lies away from the real one
+static int LapOf(int index, int count) {
+    return (index - WrapIndex(index, count)) / count;
+}
+
+static int ChunkColumnOf(const GameState* state, float x) {
+    return (int)floorf(x / (state->worldWidth / state->chunkColumns));
+}
+
+static int ChunkRowOf(const GameState* state, float y) {
+    return (int)floorf(y / (state->worldHeight / state->chunkRows));
+}
+
+// WrapPosition() leaves coordinates on [0, extent], so a point on the far
+// edge is filed in the last chunk, where queries around it will look
+static int ChunkOf(const GameState* state, Vector2 position) {
+    int column = ChunkColumnOf(state, position.x);
+    int row = ChunkRowOf(state, position.y);
+    column = (column < 0) ? 0 : (column >= state->chunkColumns) ? state->chunkColumns - 1 : column;
+    row = (row < 0) ? 0 : (row >= state->chunkRows) ? state->chunkRows - 1 : row;
+    return row * state->chunkColumns + column;
+}
+
+static void LinkSlot(ChunkLists lists, int chunk, int index) {
+    int head = lists.heads[chunk];
+    lists.chunkOf[index] = chunk;
+    lists.prev[index] = -1;
+    lists.next[index] = head;
+    if (head >= 0) lists.prev[head] = index;
+    lists.heads[chunk] = index;
+}
+
+static void UnlinkSlot(ChunkLists lists, int index) {
+    int chunk = lists.chunkOf[index];
+    if (chunk < 0) return;
+    
+    int prev = lists.prev[index];
+    int next = lists.next[index];
+    if (prev >= 0) {
+        lists.next[prev] = next;
+    } else {
+        lists.heads[chunk] = next;
+    }
+    if (next >= 0) lists.prev[next] = prev;
+    lists.chunkOf[index] = -1;
+}
+
+// The view in world space, centred on the camera; it may extend past the world's edges
+Rectangle GetWorldView(const GameState* state) {
+    return (Rectangle){
+        state->camera.x - state->screenWidth / 2,
+        state->camera.y - state->screenHeight / 2,
+        state->screenWidth,
+        state->screenHeight
+    };
+}
+
+void FollowWorldCamera(GameState* state) {
+    if (IsOpenWorld(state) && state->ship.isAlive) {
+        state->camera = state->ship.position;
+    }
+}
+
+void RebuildWorldChunks(GameState* state) {
+    if (!IsOpenWorld(state)) return;
+    
+    ChunkLists lists = GetChunkLists(state);
+    int chunkCount = state->chunkColumns * state->chunkRows;
+    for (int c = 0; c < chunkCount; c++) {
+        lists.heads[c] = -1;
+        lists.pending[c] = 0;
+    }
+    
+    // Filed from the top down so every list runs in ascending slot order
+    for (int i = state->maxAsteroids - 1; i >= 0; i--) {
+        lists.chunkOf[i] = -1;
+        if (state->asteroids[i].isActive) {
+            LinkSlot(lists, ChunkOf(state, state->asteroids[i].position), i);
+        }
+    }
+}
+
+void TrackWorldAsteroid(GameState* state, int index) {
+    if (!IsOpenWorld(state)) return;
+    
+    ChunkLists lists = GetChunkLists(state);
+    UnlinkSlot(lists, index);
+    LinkSlot(lists, ChunkOf(state, state->asteroids[index].position), index);
+}
+
+void UntrackWorldAsteroid(GameState* state, int index) {
+    if (!IsOpenWorld(state)) return;
+    UnlinkSlot(GetChunkLists(state), index);
+}
+
+static void MarkNearChunks(const GameState* state, bool* near) {
+    memset(near, 0, (size_t)state->chunkColumns * state->chunkRows * sizeof(bool));
+    
+    Rectangle view = GetWorldView(state);
+    int firstColumn = ChunkColumnOf(state, view.x) - WORLD_NEAR_MARGIN;
+    int lastColumn = ChunkColumnOf(state, view.x + view.width) + WORLD_NEAR_MARGIN;
+    int firstRow = ChunkRowOf(state, view.y) - WORLD_NEAR_MARGIN;
+    int lastRow = ChunkRowOf(state, view.y + view.height) + WORLD_NEAR_MARGIN;
+    if (lastColumn - firstColumn >= state->chunkColumns) lastColumn = firstColumn + state->chunkColumns - 1;
+    if (lastRow - firstRow >= state->chunkRows) lastRow = firstRow + state->chunkRows - 1;
+    
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            near[WrapIndex(row, state->chunkRows) * state->chunkColumns + WrapIndex(column, state->chunkColumns)] = true;
+        }
+    }
+}
+
+// Near chunks step by this tick's time. A distant chunk banks its time and
+// spends it in one coarse step on its turn; an asteroid that changes chunk
+// picks up its new chunk's clock, which is close enough out of view.
+void StepWorldAsteroids(GameState* state, float deltaTime) {
+    ChunkLists lists = GetChunkLists(state);
+    int chunkCount = state->chunkColumns * state->chunkRows;
+    bool near[WORLD_MAX_CHUNKS];
+    MarkNearChunks(state, near);
+    
+    // Slots that crossed into another chunk, chained through `next` until refiled
+    int moved = -1;
+    
+    for (int c = 0; c < chunkCount; c++) {
+        lists.pending[c] += deltaTime;
+        if (!near[c] && (state->tick + (uint32_t)c) % WORLD_COARSE_INTERVAL != 0) continue;
+        
+        float step = lists.pending[c];
+        lists.pending[c] = 0;
+        
+        for (int i = lists.heads[c]; i >= 0;) {
+            int next = lists.next[i];
+            UpdateAsteroids(&state->asteroids[i], 1, step, state->worldWidth, state->worldHeight);
+            if (ChunkOf(state, state->asteroids[i].position) != c) {
+                UnlinkSlot(lists, i);
+                lists.next[i] = moved;
+                moved = i;
+            }
+            i = next;
+        }
+    }
+    
+    while (moved >= 0) {
+        int next = lists.next[moved];
+        LinkSlot(lists, ChunkOf(state, state->asteroids[moved].position), moved);
+        moved = next;
+    }
+}
+
+// Visits the chunks within `reach` of a point. Each visit passes the offset
+// that carries the point into the chunk's side of a wrapped edge.
+typedef struct {
+    int firstColumn;
+    int lastColumn;
+    int firstRow;
+    int lastRow;
+} ChunkRange;
+
+static ChunkRange GetChunkRange(const GameState* state, Vector2 center, float reach) {
+    return (ChunkRange){
+        ChunkColumnOf(state, center.x - reach),
+        ChunkColumnOf(state, center.x + reach),
+        ChunkRowOf(state, center.y - reach),
+        ChunkRowOf(state, center.y + reach)
+    };
+}
+
+static Vector2 GetWrapShift(const GameState* state, int column, int row) {
+    return (Vector2){
+        (WrapIndex(column, state->chunkColumns) - column) * (state->worldWidth / state->chunkColumns),
+        (WrapIndex(row, state->chunkRows) - row) * (state->worldHeight / state->chunkRows)
+    };
+}
+
+int QueryAsteroidHit(const GameState* state, Vector2 center, float radius) {
+    if (!IsOpenWorld(state)) return FindAsteroidHit(state->asteroids, state->maxAsteroids, center, radius);
+    
+    ChunkLists lists = GetChunkLists(state);
+    ChunkRange range = GetChunkRange(state, center, radius + WORLD_MAX_ASTEROID_REACH);
+    
+    for (int row = range.firstRow; row <= range.lastRow; row++) {
+        for (int column = range.firstColumn; column <= range.lastColumn; column++) {
+            Vector2 shift = GetWrapShift(state, column, row);
+            Vector2 probe = {center.x + shift.x, center.y + shift.y};
+            int chunk = WrapIndex(row, state->chunkRows) * state->chunkColumns + WrapIndex(column, state->chunkColumns);
+            
+            for (int i = lists.heads[chunk]; i >= 0; i = lists.next[i]) {
+                const Asteroid* asteroid = &state->asteroids[i];
+                if (CheckCirclesOverlap(probe, radius, asteroid->position, asteroid->radius * ASTEROID_SHAPE_MAX_SCALE) &&
+                    CheckAsteroidCircleHit(asteroid, i, probe, radius)) {
+                    return i;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+int QueryShipAsteroidHit(const GameState* state) {
+    const Spaceship* ship = &state->ship;
+    if (!IsOpenWorld(state)) return FindShipAsteroidHit(state->asteroids, state->maxAsteroids, ship);
+    
+    Vector2 hull[3];
+    Vector2 flame[3];
+    GetSpaceshipOutline(ship, hull, flame);
+    
+    ChunkLists lists = GetChunkLists(state);
+    ChunkRange range = GetChunkRange(state, ship->position, SPACESHIP_BOUND_RADIUS + WORLD_MAX_ASTEROID_REACH);
+    
+    for (int row = range.firstRow; row <= range.lastRow; row++) {
+        for (int column = range.firstColumn; column <= range.lastColumn; column++) {
+            Vector2 shift = GetWrapShift(state, column, row);
+            Vector2 center = {ship->position.x + shift.x, ship->position.y + shift.y};
+            Vector2 shifted[3];
+            for (int k = 0; k < 3; k++) {
+                shifted[k] = (Vector2){hull[k].x + shift.x, hull[k].y + shift.y};
+            }
+            int chunk = WrapIndex(row, state->chunkRows) * state->chunkColumns + WrapIndex(column, state->chunkColumns);
+            
+            for (int i = lists.heads[chunk]; i >= 0; i = lists.next[i]) {
+                const Asteroid* asteroid = &state->asteroids[i];
+                if (CheckCirclesOverlap(center, SPACESHIP_BOUND_RADIUS, asteroid->position,
+                                        asteroid->radius * ASTEROID_SHAPE_MAX_SCALE) &&
+                    CheckAsteroidHullHit(asteroid, i, shifted)) {
+                    return i;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// Draws the chunks under the view. Where the view crosses a wrapped edge the
+// world is drawn once per side, each pass translated so the seam lines up;
+// everything other than asteroids is cheap enough to draw in every pass.
+void DrawWorld(const GameState* state) {
+    ChunkLists lists = GetChunkLists(state);
+    Rectangle view = GetWorldView(state);
+    ChunkRange range = {
+        ChunkColumnOf(state, view.x - WORLD_MAX_ASTEROID_REACH),
+        ChunkColumnOf(state, view.x + view.width + WORLD_MAX_ASTEROID_REACH),
+        ChunkRowOf(state, view.y - WORLD_MAX_ASTEROID_REACH),
+        ChunkRowOf(state, view.y + view.height + WORLD_MAX_ASTEROID_REACH)
+    };
+    
+    // Each pass covers the chunks that share one whole-world shift
+    int firstLapX = LapOf(range.firstColumn, state->chunkColumns);
+    int lastLapX = LapOf(range.lastColumn, state->chunkColumns);
+    int firstLapY = LapOf(range.firstRow, state->chunkRows);
+    int lastLapY = LapOf(range.lastRow, state->chunkRows);
+    
+    for (int lapY = firstLapY; lapY <= lastLapY; lapY++) {
+        for (int lapX = firstLapX; lapX <= lastLapX; lapX++) {
+            int count = 0;
+            for (int row = range.firstRow; row <= range.lastRow; row++) {
+                if (LapOf(row, state->chunkRows) != lapY) continue;
+                for (int column = range.firstColumn; column <= range.lastColumn; column++) {
+                    if (LapOf(column, state->chunkColumns) != lapX) continue;
+                    
+                    int chunk = WrapIndex(row, state->chunkRows) * state->chunkColumns + WrapIndex(column, state->chunkColumns);
+                    for (int i = lists.heads[chunk]; i >= 0 && count < MAX_SWARM_ASTEROIDS; i = lists.next[i]) {
+                        visibleAsteroids[count++] = state->asteroids[i];
+                    }
+                }
+            }
+            
+            rlPushMatrix();
+            rlTranslatef(lapX * state->worldWidth - view.x, lapY * state->worldHeight - view.y, 0);
+            
+            DrawSpaceship(&state->ship, GetShipInvulnerableTime(state));
+            DrawAsteroidsInstanced(visibleAsteroids, count);
+            for (int i = 0; i < MAX_BULLETS; i++) {
+                DrawBullet(&state->bullets[i]);
+            }
+            for (int i = 0; i < MAX_UFOS; i++) {
+                DrawUFO(&state->ufos[i]);
+            }
+            DrawParticles();
+            
+            rlPopMatrix();
+        }
+    }
+}
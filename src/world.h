@@ -0,0 +1,36 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "game.h"
+
+// Open-space worlds are several screens across and viewed through a camera
+// that follows the ship. Asteroid slots are filed into per-chunk lists stored
+// after the asteroid array, so a state is still one flat block. Chunks around
+// the view step every tick and take part in collisions; distant chunks step
+// once every WORLD_COARSE_INTERVAL ticks, staggered so each tick pays for a
+// slice of them. Per-tick cost follows what is near the view, not world population.
+
+#define WORLD_CHUNK_SIZE 512.0f
+#define WORLD_MAX_CHUNKS 1024
+#define WORLD_NEAR_MARGIN 1
+#define WORLD_COARSE_INTERVAL 8
+#define WORLD_SCREENS_WIDE 6
+#define WORLD_SCREENS_HIGH 6
+
+bool IsOpenWorld(const GameState* state);
+void GetWorldChunkGrid(float worldWidth, float worldHeight, int* columns, int* rows);
+size_t GetWorldChunkBytes(int chunkCount, int maxAsteroids);
+Rectangle GetWorldView(const GameState* state);
+void FollowWorldCamera(GameState* state);
+
+void RebuildWorldChunks(GameState* state);
+void TrackWorldAsteroid(GameState* state, int index);
+void UntrackWorldAsteroid(GameState* state, int index);
+void StepWorldAsteroids(GameState* state, float deltaTime);
+
+int QueryAsteroidHit(const GameState* state, Vector2 center, float radius);
+int QueryShipAsteroidHit(const GameState* state);
+
+void DrawWorld(const GameState* state);
+
+#endif
@@ -0,0 +1,405 @@
+#include "game.h"
+#include "collision.h"
+#include "env.h"
+#include "statehash.h"
+#include "utils.h"
+#include "world.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Headless throughput benchmarks over the game rules. Build with `make bench`,
+// which produces one binary per physics mode so the two can be compared:
+//
+//   ./bin/bench_float physics --ticks=20000
+//   ./bin/bench_fixed physics --ticks=20000
+//
+// The checksum covers every entity's position and velocity after the run.
+// bench_fixed prints the same checksum on every platform; bench_float may not.
+
+#define BENCH_DEFAULT_TICKS 10000
+#define BENCH_TICK_DT (1.0f / ENV_TICK_RATE)
+#define BENCH_SEED 0x5EEDBA5Eu
+#define BENCH_PROBES MAX_BULLETS
+
+#if defined(FIXED_POINT_PHYSICS)
+    #define BENCH_PHYSICS_NAME "fixed"
+#else
+    #define BENCH_PHYSICS_NAME "float"
+#endif
+
+typedef struct {
+    int ticks;
+} BenchOptions;
+
+// digestSeconds is the part of seconds spent in UpdateStateHasher, timed on
+// its own since whole runs vary by more than the digest costs
+typedef struct {
+    double seconds;
+    double digestSeconds;
+    long long entityUpdates;
+    uint64_t checksum;
+} BenchResult;
+
+typedef BenchResult (*BenchFunction)(const BenchOptions* options);
+
+// A scenario with a baseline must reproduce the baseline's checksum, or its
+// timing is not a comparison of the same work and is not reported
+typedef struct {
+    const char* name;
+    const char* description;
+    BenchFunction run;
+    BenchFunction baseline;
+} BenchScenario;
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static uint64_t HashMotion(uint64_t hash, bool active, Vector2 position, Vector2 velocity) {
+    if (!active) return HashBytes(hash, &active, sizeof(active));
+    float values[4] = { position.x, position.y, velocity.x, velocity.y };
+    return HashBytes(hash, values, sizeof(values));
+}
+
+// Field by field, so padding and pointers never reach the hash
+static uint64_t HashGameState(const GameState* state) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    
+    hash = HashMotion(hash, state->ship.isAlive, state->ship.position, state->ship.velocity);
+    hash = HashBytes(hash, &state->ship.rotation, sizeof(state->ship.rotation));
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        const Asteroid* asteroid = &state->asteroids[i];
+        hash = HashMotion(hash, asteroid->isActive, asteroid->position, asteroid->velocity);
+    }
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        hash = HashMotion(hash, state->bullets[i].isActive, state->bullets[i].position, state->bullets[i].velocity);
+    }
+    for (int i = 0; i < MAX_UFOS; i++) {
+        hash = HashMotion(hash, state->ufos[i].isActive, state->ufos[i].position, state->ufos[i].velocity);
+    }
+    hash = HashBytes(hash, &state->score, sizeof(state->score));
+    return hash;
+}
+
+static int CountActiveEntities(const GameState* state) {
+    int count = state->ship.isAlive ? 1 : 0;
+    for (int i = 0; i < state->maxAsteroids; i++) count += state->asteroids[i].isActive;
+    for (int i = 0; i < MAX_BULLETS; i++) count += state->bullets[i].isActive;
+    for (int i = 0; i < MAX_UFOS; i++) count += state->ufos[i].isActive;
+    return count;
+}
+
+// Scripted pilot: holds each control combination for a few ticks, chosen by
+// a private LCG so the script never touches the game's random stream
+static unsigned int NextScriptedActions(uint32_t* script) {
+    static const unsigned int patterns[] = {
+        ACTION_THRUST | ACTION_FIRE,
+        ACTION_ROTATE_LEFT | ACTION_FIRE,
+        ACTION_ROTATE_RIGHT | ACTION_THRUST,
+        ACTION_FIRE,
+        ACTION_ROTATE_LEFT | ACTION_THRUST | ACTION_FIRE,
+        0
+    };
+    *script = *script * 1664525u + 1013904223u;
+    return patterns[(*script >> 16) % (sizeof(patterns) / sizeof(patterns[0]))];
+}
+
+// Plays the scripted pilot through a level set and destroys the state.
+// With hashing on, the state digest is updated after every tick as a
+// recording would.
+static BenchResult RunScriptedGame(const BenchOptions* options, GameState* state, LevelSetId levelSet, bool hashed) {
+    BenchResult result = { 0 };
+    StateHasher hasher;
+    if (!state || !InitStateHasher(&hasher, state->maxAsteroids)) return result;
+    state->levelSet = levelSet;
+    
+    SeedRandom(BENCH_SEED);
+    InitGame(state);
+    StartNewGame(state);
+    ResetStateHasher(&hasher, state);
+    
+    uint32_t script = BENCH_SEED;
+    unsigned int actions = 0;
+    double start = GetMonotonicTime();
+    
+    for (int tick = 0; tick < options->ticks; tick++) {
+        if (tick % 8 == 0) actions = NextScriptedActions(&script);
+        if (state->state != GAME_STATE_PLAYING) StartNewGame(state);
+        
+        ApplyShipActions(state, actions);
+        UpdateGame(state, BENCH_TICK_DT);
+        if (hashed) {
+            double digestStart = GetMonotonicTime();
+            UpdateStateHasher(&hasher, state);
+            result.digestSeconds += GetMonotonicTime() - digestStart;
+        }
+        result.entityUpdates += CountActiveEntities(state);
+    }
+    
+    result.seconds = GetMonotonicTime() - start;
+    result.checksum = HashGameState(state);
+    FreeStateHasher(&hasher);
+    DestroyGameState(state);
+    return result;
+}
+
+// Swarm levels at full capacity: movement, wrapping and collision for thousands of asteroids
+static BenchResult RunPhysicsBench(const BenchOptions* options) {
+    GameState* state = CreateGameStateEx(ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT, MAX_SWARM_ASTEROIDS);
+    return RunScriptedGame(options, state, LEVEL_SET_SWARM, false);
+}
+
+static BenchResult RunHashedPhysicsBench(const BenchOptions* options) {
+    GameState* state = CreateGameStateEx(ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT, MAX_SWARM_ASTEROIDS);
+    return RunScriptedGame(options, state, LEVEL_SET_SWARM, true);
+}
+
+// Open space: a world of many screens where only chunks near the view step every tick
+static BenchResult RunWorldBench(const BenchOptions* options) {
+    GameState* state = CreateWorldGameState(ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT,
+                                            ENV_PLAYFIELD_WIDTH * WORLD_SCREENS_WIDE,
+                                            ENV_PLAYFIELD_HEIGHT * WORLD_SCREENS_HIGH,
+                                            MAX_SWARM_ASTEROIDS, 0);
+    return RunScriptedGame(options, state, LEVEL_SET_OPEN_SPACE, false);
+}
+
+// Asteroid slots at swarm capacity, three quarters active, for the kernel scenarios
+static Asteroid* CreateKernelField(uint64_t seed) {
+    Asteroid* asteroids = calloc(MAX_SWARM_ASTEROIDS, sizeof(Asteroid));
+    if (!asteroids) return nullptr;
+    
+    SeedRandom(seed);
+    for (int i = 0; i < MAX_SWARM_ASTEROIDS; i++) {
+        InitAsteroid(&asteroids[i], RandomFloat(0, ENV_PLAYFIELD_WIDTH), RandomFloat(0, ENV_PLAYFIELD_HEIGHT),
+                     (AsteroidSize)RandomInt(ASTEROID_LARGE, ASTEROID_SMALL));
+        asteroids[i].isActive = RandomInt(0, 3) != 0;
+    }
+    return asteroids;
+}
+
+// Active slots only: the kernels step inactive slots by zero, which the fixed
+// build quantizes, while the reference skips them
+static uint64_t HashKernelField(uint64_t hits, const Asteroid* asteroids) {
+    uint64_t hash = HashBytes(0xCBF29CE484222325ull, &hits, sizeof(hits));
+    for (int i = 0; i < MAX_SWARM_ASTEROIDS; i++) {
+        const Asteroid* asteroid = &asteroids[i];
+        hash = HashMotion(hash, asteroid->isActive, asteroid->position, asteroid->velocity);
+        if (asteroid->isActive) hash = HashBytes(hash, &asteroid->rotation, sizeof(asteroid->rotation));
+    }
+    return hash;
+}
+
+static Vector2 NextProbe(uint32_t* script) {
+    *script = *script * 1664525u + 1013904223u;
+    float x = (*script >> 8) / (float)(1u << 24) * ENV_PLAYFIELD_WIDTH;
+    *script = *script * 1664525u + 1013904223u;
+    float y = (*script >> 8) / (float)(1u << 24) * ENV_PLAYFIELD_HEIGHT;
+    return (Vector2){x, y};
+}
+
+// Each tick moves every slot, then scans the field for a bullet-sized probe per bullet slot
+static BenchResult RunKernelBench(const BenchOptions* options) {
+    BenchResult result = { 0 };
+    Asteroid* asteroids = CreateKernelField(BENCH_SEED);
+    if (!asteroids) return result;
+    
+    uint32_t script = BENCH_SEED;
+    uint64_t hits = 0;
+    double start = GetMonotonicTime();
+    
+    for (int tick = 0; tick < options->ticks; tick++) {
+        UpdateAsteroids(asteroids, MAX_SWARM_ASTEROIDS, BENCH_TICK_DT, ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT);
+        for (int p = 0; p < BENCH_PROBES; p++) {
+            hits += (uint64_t)(FindAsteroidOverlap(asteroids, 0, MAX_SWARM_ASTEROIDS, NextProbe(&script), BULLET_RADIUS) + 1);
+        }
+    }
+    
+    result.seconds = GetMonotonicTime() - start;
+    result.entityUpdates = (long long)options->ticks * MAX_SWARM_ASTEROIDS * (1 + BENCH_PROBES);
+    result.checksum = HashKernelField(hits, asteroids);
+    free(asteroids);
+    return result;
+}
+
+// The per-entity shape the kernels replaced: a skip branch per slot and a
+// radius chosen by a runtime switch on size
+static float ReferenceRadius(AsteroidSize size) {
+    switch (size) {
+        case ASTEROID_LARGE: return ASTEROID_LARGE_RADIUS;
+        case ASTEROID_MEDIUM: return ASTEROID_MEDIUM_RADIUS;
+        case ASTEROID_SMALL: return ASTEROID_SMALL_RADIUS;
+    }
+    return 0;
+}
+
+static BenchResult RunKernelReferenceBench(const BenchOptions* options) {
+    BenchResult result = { 0 };
+    Asteroid* asteroids = CreateKernelField(BENCH_SEED);
+    if (!asteroids) return result;
+    
+    uint32_t script = BENCH_SEED;
+    uint64_t hits = 0;
+    double start = GetMonotonicTime();
+    
+    for (int tick = 0; tick < options->ticks; tick++) {
+        for (int i = 0; i < MAX_SWARM_ASTEROIDS; i++) {
+            Asteroid* asteroid = &asteroids[i];
+            if (!asteroid->isActive) continue;
+            asteroid->position.x = Integrate(asteroid->position.x, asteroid->velocity.x, BENCH_TICK_DT);
+            asteroid->position.y = Integrate(asteroid->position.y, asteroid->velocity.y, BENCH_TICK_DT);
+            asteroid->rotation = IntegrateDegrees(asteroid->rotation, asteroid->rotationSpeed, BENCH_TICK_DT);
+            WrapPosition(&asteroid->position, ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT);
+        }
+        for (int p = 0; p < BENCH_PROBES; p++) {
+            Vector2 probe = NextProbe(&script);
+            int found = -1;
+            for (int i = 0; i < MAX_SWARM_ASTEROIDS; i++) {
+                if (!asteroids[i].isActive) continue;
+                float bound = ReferenceRadius(asteroids[i].size) * ASTEROID_SHAPE_MAX_SCALE;
+                if (CheckCirclesOverlap(probe, BULLET_RADIUS, asteroids[i].position, bound)) {
+                    found = i;
+                    break;
+                }
+            }
+            hits += (uint64_t)(found + 1);
+        }
+    }
+    
+    result.seconds = GetMonotonicTime() - start;
+    result.entityUpdates = (long long)options->ticks * MAX_SWARM_ASTEROIDS * (1 + BENCH_PROBES);
+    result.checksum = HashKernelField(hits, asteroids);
+    free(asteroids);
+    return result;
+}
+
+// The circle test the game used before the outline narrowphase: each
+// asteroid as a circle of its nominal radius
+static int FindAsteroidCircleHit(const Asteroid* asteroids, int count, Vector2 center, float radius) {
+    for (int i = 0; i < count; i++) {
+        if (asteroids[i].isActive && CheckCirclesOverlap(center, radius, asteroids[i].position, asteroids[i].radius)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Bullet and ship probes against a still field, with nominal circles or with
+// the bounding-circle prefilter and outline narrowphase the game uses. The two
+// tests disagree on which probes hit, so their checksums differ and the timings
+// compare the old test with the new one rather than two ways of doing the same work.
+static BenchResult RunCollisionBench(const BenchOptions* options, bool outlines) {
+    BenchResult result = { 0 };
+    Asteroid* asteroids = CreateKernelField(BENCH_SEED);
+    if (!asteroids) return result;
+    
+    Spaceship ship;
+    InitSpaceship(&ship, 0, 0);
+    uint32_t script = BENCH_SEED;
+    uint64_t hits = 0;
+    double start = GetMonotonicTime();
+    
+    for (int tick = 0; tick < options->ticks; tick++) {
+        for (int p = 0; p < BENCH_PROBES; p++) {
+            Vector2 probe = NextProbe(&script);
+            int hit = outlines ? FindAsteroidHit(asteroids, MAX_SWARM_ASTEROIDS, probe, BULLET_RADIUS)
+                               : FindAsteroidCircleHit(asteroids, MAX_SWARM_ASTEROIDS, probe, BULLET_RADIUS);
+            hits += (hit >= 0);
+        }
+        
+        ship.position = NextProbe(&script);
+        ship.rotation = (float)(tick % 360);
+        int hit = outlines ? FindShipAsteroidHit(asteroids, MAX_SWARM_ASTEROIDS, &ship)
+                           : FindAsteroidCircleHit(asteroids, MAX_SWARM_ASTEROIDS, ship.position, SPACESHIP_SIZE);
+        hits += (hit >= 0);
+    }
+    
+    result.seconds = GetMonotonicTime() - start;
+    result.entityUpdates = (long long)options->ticks * MAX_SWARM_ASTEROIDS * (BENCH_PROBES + 1);
+    result.checksum = hits;
+    free(asteroids);
+    return result;
+}
+
+static BenchResult RunCircleCollisionBench(const BenchOptions* options) {
+    return RunCollisionBench(options, false);
+}
+
+static BenchResult RunOutlineCollisionBench(const BenchOptions* options) {
+    return RunCollisionBench(options, true);
+}
+
+static const BenchScenario scenarios[] = {
+    { "physics", "swarm levels stepped with a scripted pilot", RunPhysicsBench, nullptr },
+    { "physics-hash", "the same game with the per-tick state digest; reports its share", RunHashedPhysicsBench, nullptr },
+    { "world", "open-space levels with chunked, level-of-detail asteroid updates", RunWorldBench, nullptr },
+    { "kernels", "generated asteroid move and overlap kernels at swarm capacity", RunKernelBench, nullptr },
+    { "kernels-ref", "the same work as per-entity branches and a runtime size switch", RunKernelReferenceBench, RunKernelBench },
+    { "collide", "bullet and ship probes against nominal circles; checksum counts hits", RunCircleCollisionBench, nullptr },
+    { "collide-poly", "the same probes against outlines; different hits, so not like-for-like", RunOutlineCollisionBench, nullptr },
+};
+
+#define SCENARIO_COUNT ((int)(sizeof(scenarios) / sizeof(scenarios[0])))
+
+static void PrintUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [scenario] [--ticks=N]\n\nScenarios:\n", program);
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        fprintf(stderr, "  %-12s %s\n", scenarios[i].name, scenarios[i].description);
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options = { .ticks = BENCH_DEFAULT_TICKS };
+    const char* selected = nullptr;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--ticks=", 8) == 0) {
+            options.ticks = atoi(argv[i] + 8);
+        } else if (argv[i][0] != '-' && !selected) {
+            selected = argv[i];
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.ticks < 1) options.ticks = 1;
+    
+    // Benchmarks measure simulation only: no sound, particles or telemetry
+    SetEffectsEnabled(false);
+    
+    int ran = 0;
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        if (selected && strcmp(selected, scenarios[i].name) != 0) continue;
+        ran++;
+        
+        BenchResult result = scenarios[i].run(&options);
+        if (scenarios[i].baseline) {
+            BenchResult baseline = scenarios[i].baseline(&options);
+            if (baseline.checksum != result.checksum) {
+                fprintf(stderr, "%s: checksum %016llx does not match its baseline's %016llx\n", scenarios[i].name,
+                        (unsigned long long)result.checksum, (unsigned long long)baseline.checksum);
+                return 1;
+            }
+        }
+        
+        double seconds = result.seconds > 0 ? result.seconds : 1e-9;
+        printf("%-12s %s  %d ticks in %.3f s  %.0f ticks/s  %.2fM entity updates/s  checksum %016llx\n",
+               scenarios[i].name, BENCH_PHYSICS_NAME, options.ticks, result.seconds,
+               options.ticks / seconds, result.entityUpdates / seconds / 1e6,
+               (unsigned long long)result.checksum);
+        if (result.digestSeconds > 0) {
+            printf("%-12s %s  state digest %.3f s, %.2f%% of the run\n", "", BENCH_PHYSICS_NAME,
+                   result.digestSeconds, 100.0 * result.digestSeconds / seconds);
+        }
+    }
+    
+    if (ran == 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
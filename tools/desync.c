@@ -0,0 +1,257 @@
+#include "game.h"
+#include "replay.h"
+#include "statehash.h"
+#include "utils.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Finds where two runs of a game part ways, replaying under the tuning table
+// each recording was played with. Build with `make desync`:
+//
+//   ./bin/desync game.replay                 replay in this build, compare with the recording
+//   ./bin/desync a.replay b.replay           compare two recordings of the same game
+//   ./bin/desync game.replay --dump=TICK     print every entity's slot hash at TICK
+//   ./bin/desync game.replay --trace=SLOTS   print asteroid SLOTS (N or N-M) every tick
+//
+// Both comparisons report the first tick whose digest differs and the entity
+// groups that differ there. Bullets, UFOs, the ship and globals are hashed
+// every tick, so that tick is exact for them; dump it from each side (each
+// build, platform or physics mode) and diff the dumps to name the entity.
+//
+// Asteroid slots are only rehashed once per period, so an asteroid mismatch
+// names the slot, solved from the digest, and the period it diverged in.
+// Tracing that slot from each side rehashes it every tick, and the first
+// differing line of the two traces is the exact tick.
+
+static void PrintDifference(const Replay* replay, const ReplayTick* expected, const StateDigest* actual) {
+    printf("first divergent tick: %u\n", expected->tick);
+    
+    for (int g = 0; g < STATE_HASH_GROUP_COUNT; g++) {
+        if (expected->digest.groups[g] == actual->groups[g]) continue;
+        printf("  %-10s %016llx != %016llx\n", GetStateHashGroupName(g),
+               (unsigned long long)expected->digest.groups[g], (unsigned long long)actual->groups[g]);
+    }
+    
+    // Asteroid slots are refreshed a window per tick, so the culprit is in this
+    // tick's window and matched at the window's previous refresh
+    if (expected->digest.groups[STATE_HASH_ASTEROIDS] != actual->groups[STATE_HASH_ASTEROIDS]) {
+        uint32_t period = (uint32_t)GetStateHashPeriod(replay->header.maxAsteroids);
+        int first = (int)(expected->tick % period) * STATE_HASH_WINDOW;
+        int last = first + STATE_HASH_WINDOW - 1;
+        if (last >= replay->header.maxAsteroids) last = replay->header.maxAsteroids - 1;
+        
+        int slot = LocateAsteroidSlot(&expected->digest, actual, replay->header.maxAsteroids);
+        if (slot >= first && slot <= last) {
+            first = last = slot;
+            printf("  asteroid slot %d diverged", slot);
+        } else {
+            printf("  more than one of asteroid slots %d-%d diverged", first, last);
+        }
+        
+        if (period > 1) {
+            uint32_t since = expected->tick > period ? expected->tick - period + 1 : 1;
+            printf(" between ticks %u and %u\n", since, expected->tick);
+            printf("  run with --trace=%d", first);
+            if (last != first) printf("-%d", last);
+            printf(" on each side and diff the output for the exact tick\n");
+        } else {
+            printf(" at this tick\n");
+        }
+    }
+}
+
+// Replays the recording's inputs and checks every tick against its digest
+static int CheckReplay(const Replay* replay) {
+    GameState* state = CreateReplayGameState(replay);
+    StateHasher hasher;
+    if (!state || !InitStateHasher(&hasher, replay->header.maxAsteroids)) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    
+    int result = 0;
+    uint32_t retunedTick = replay->header.retunedTick;
+    for (int i = 0; i < replay->tickCount; i++) {
+        const ReplayTick* tick = &replay->ticks[i];
+        if (retunedTick != 0 && tick->tick >= retunedTick) {
+            printf("tuning table reloaded mid-game; ticks from %u on cannot be replayed\n", retunedTick);
+            break;
+        }
+        StepReplay(state, tick);
+        
+        if (i == 0) {
+            ResetStateHasher(&hasher, state);
+        } else {
+            UpdateStateHasher(&hasher, state);
+        }
+        
+        if (state->tick != tick->tick || memcmp(&hasher.digest, &tick->digest, sizeof(StateDigest)) != 0) {
+            PrintDifference(replay, tick, &hasher.digest);
+            result = 2;
+            break;
+        }
+    }
+    
+    if (result == 0) {
+        printf("%u ticks match, final score %d\n", state->tick, state->score);
+    }
+    FreeStateHasher(&hasher);
+    DestroyGameState(state);
+    return result;
+}
+
+static int CompareReplays(const Replay* a, const Replay* b) {
+    // The final scores may differ exactly because the games diverged
+    if (memcmp(&a->header, &b->header, offsetof(ReplayHeader, score)) != 0) {
+        printf("recordings are of different games\n");
+        return 2;
+    }
+    
+    int count = a->tickCount < b->tickCount ? a->tickCount : b->tickCount;
+    for (int i = 0; i < count; i++) {
+        const ReplayTick* left = &a->ticks[i];
+        const ReplayTick* right = &b->ticks[i];
+        if (left->actions != right->actions || left->deltaTime != right->deltaTime) {
+            printf("inputs differ at tick %u before any state diverged\n", left->tick);
+            return 2;
+        }
+        if (left->tick != right->tick || memcmp(&left->digest, &right->digest, sizeof(StateDigest)) != 0) {
+            PrintDifference(a, left, &right->digest);
+            return 2;
+        }
+    }
+    
+    printf("%d ticks match", count);
+    if (a->tickCount != b->tickCount) printf(" (recordings have %d and %d ticks)", a->tickCount, b->tickCount);
+    printf("\n");
+    return 0;
+}
+
+static int DumpTick(const Replay* replay, uint32_t target) {
+    GameState* state = CreateReplayGameState(replay);
+    if (!state) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    
+    for (int i = 0; i < replay->tickCount && state->tick < target; i++) {
+        StepReplay(state, &replay->ticks[i]);
+    }
+    if (state->tick != target) {
+        fprintf(stderr, "Recording ends at tick %u\n", state->tick);
+        DestroyGameState(state);
+        return 1;
+    }
+    
+    printf("tick %u score %d level %d asteroids %d random %016llx\n", state->tick, state->score, state->level,
+           state->asteroidCount, (unsigned long long)GetRandomState());
+    printf("ship %.9g %.9g %.9g %.9g %.9g\n", state->ship.position.x, state->ship.position.y,
+           state->ship.velocity.x, state->ship.velocity.y, state->ship.rotation);
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (!state->bullets[i].isActive) continue;
+        printf("bullet %d %016llx %.9g %.9g\n", i, (unsigned long long)HashBulletSlot(&state->bullets[i], i),
+               state->bullets[i].position.x, state->bullets[i].position.y);
+    }
+    for (int i = 0; i < MAX_UFOS; i++) {
+        if (!state->ufos[i].isActive) continue;
+        printf("ufo %d %016llx %.9g %.9g\n", i, (unsigned long long)HashUFOSlot(&state->ufos[i], i),
+               state->ufos[i].position.x, state->ufos[i].position.y);
+    }
+    for (int i = 0; i < state->maxAsteroids; i++) {
+        if (!state->asteroids[i].isActive) continue;
+        printf("asteroid %d %016llx %.9g %.9g\n", i, (unsigned long long)HashAsteroidSlot(&state->asteroids[i], i),
+               state->asteroids[i].position.x, state->asteroids[i].position.y);
+    }
+    
+    DestroyGameState(state);
+    return 0;
+}
+
+// Rehashes the slots every tick: the first line that differs between two
+// sides' traces is the exact tick and slot
+static int TraceAsteroids(const Replay* replay, int first, int last) {
+    GameState* state = CreateReplayGameState(replay);
+    if (!state) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    if (first < 0) first = 0;
+    if (last >= state->maxAsteroids) last = state->maxAsteroids - 1;
+    
+    for (int i = 0; i < replay->tickCount; i++) {
+        StepReplay(state, &replay->ticks[i]);
+        for (int slot = first; slot <= last; slot++) {
+            const Asteroid* asteroid = &state->asteroids[slot];
+            printf("tick %u asteroid %d %016llx %.9g %.9g\n", state->tick, slot,
+                   (unsigned long long)HashAsteroidSlot(asteroid, slot), asteroid->position.x, asteroid->position.y);
+        }
+    }
+    
+    DestroyGameState(state);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* paths[2] = { nullptr, nullptr };
+    int pathCount = 0;
+    long dumpTick = -1;
+    long traceFirst = -1, traceLast = -1;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--dump=", 7) == 0) {
+            dumpTick = atol(argv[i] + 7);
+        } else if (strncmp(argv[i], "--trace=", 8) == 0) {
+            char* end;
+            traceFirst = traceLast = strtol(argv[i] + 8, &end, 10);
+            if (*end == '-') traceLast = strtol(end + 1, nullptr, 10);
+        } else if (argv[i][0] != '-' && pathCount < 2) {
+            paths[pathCount++] = argv[i];
+        } else {
+            pathCount = 0;
+            break;
+        }
+    }
+    bool singleMode = dumpTick >= 0 || traceFirst >= 0;
+    if (pathCount == 0 || (singleMode && pathCount != 1) || (dumpTick >= 0 && traceFirst >= 0)) {
+        fprintf(stderr, "Usage: %s game.replay [other.replay] [--dump=TICK | --trace=SLOT[-SLOT]]\n", argv[0]);
+        return 1;
+    }
+    
+    // Replays are simulation only: no sound, particles or telemetry
+    SetEffectsEnabled(false);
+    
+    Replay replays[2];
+    for (int i = 0; i < pathCount; i++) {
+        if (!LoadReplay(paths[i], &replays[i])) {
+            fprintf(stderr, "Failed to load replay: %s\n", paths[i]);
+            return 1;
+        }
+    }
+    
+    // Both recordings of a comparison share a table, or their headers already differ
+    const char* problem = CheckTuningTable(&replays[0].header.tuning);
+    if (problem) {
+        fprintf(stderr, "Recording has an invalid tuning table (%s out of range)\n", problem);
+        for (int i = 0; i < pathCount; i++) UnloadReplay(&replays[i]);
+        return 1;
+    }
+    SetTuningTable(&replays[0].header.tuning);
+    
+    int result;
+    if (dumpTick >= 0) {
+        result = DumpTick(&replays[0], (uint32_t)dumpTick);
+    } else if (traceFirst >= 0) {
+        result = TraceAsteroids(&replays[0], (int)traceFirst, (int)traceLast);
+    } else if (pathCount == 2) {
+        result = CompareReplays(&replays[0], &replays[1]);
+    } else {
+        result = CheckReplay(&replays[0]);
+    }
+    
+    for (int i = 0; i < pathCount; i++) {
+        UnloadReplay(&replays[i]);
+    }
+    return result;
+}
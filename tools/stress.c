@@ -0,0 +1,78 @@
+#include "game.h"
+#include "scenarios.h"
+#include "utils.h"
+#include "env.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sweeps the stress scenarios over asteroid counts and prints per-tick time
+// by UpdateGame phase for each count. Build with `make stress`:
+//
+//   ./bin/stress                                 every scenario, 64 to 4096 asteroids
+//   ./bin/stress split-storm --counts=500,1000,2000,4000 --ticks=1200
+//
+// Rows are whitespace-separated with a '#' header, so the output plots
+// directly. Headless runs have effects off, as the benchmarks do; run the game
+// with --stress=SCENARIO for the same sweep with rendering and frame times.
+
+#define STRESS_SEED 0x5EEDBA5Eu
+
+static void PrintUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [scenario] [--counts=N,N,...] [--ticks=N]\n\nScenarios:\n", program);
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        fprintf(stderr, "  %-12s %s\n", GetScenarioName(i), GetScenarioDescription(i));
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* countList = nullptr;
+    int selected = -1;
+    int ticks = SCENARIO_DEFAULT_TICKS;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--counts=", 9) == 0) {
+            countList = argv[i] + 9;
+        } else if (strncmp(argv[i], "--ticks=", 8) == 0) {
+            ticks = atoi(argv[i] + 8);
+        } else if (argv[i][0] != '-' && selected < 0 && FindScenario(argv[i]) >= 0) {
+            selected = FindScenario(argv[i]);
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (ticks < 1) ticks = 1;
+    
+    int counts[SCENARIO_MAX_COUNTS];
+    int countCount = ParseScenarioCounts(countList, MAX_SWARM_ASTEROIDS, counts);
+    if (countCount == 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    
+    GameState* state = CreateGameStateEx(ENV_PLAYFIELD_WIDTH, ENV_PLAYFIELD_HEIGHT, MAX_SWARM_ASTEROIDS);
+    if (!state) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    SetEffectsEnabled(false);
+    
+    WriteScenarioHeader(stdout, false);
+    for (int s = 0; s < SCENARIO_COUNT; s++) {
+        if (selected >= 0 && s != selected) continue;
+        
+        for (int c = 0; c < countCount; c++) {
+            ScenarioRun run;
+            SeedRandom(STRESS_SEED);
+            BeginScenarioRun(&run, state, s, counts[c]);
+            while (!IsScenarioRunDone(&run, ticks)) {
+                StepScenarioRun(&run, state);
+            }
+            WriteScenarioSample(stdout, &run, false);
+        }
+    }
+    
+    DestroyGameState(state);
+    return 0;
+}
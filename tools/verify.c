@@ -0,0 +1,361 @@
+#define _POSIX_C_SOURCE 200809L
+#include "game.h"
+#include "jobs.h"
+#include "replay.h"
+#include "statehash.h"
+#include "tuning.h"
+#include "utils.h"
+#include "world.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checks submitted games by playing each recording again in this build. Build
+// with `make verify`:
+//
+//   ./bin/verify submissions/                    every .replay file in the directory
+//   ./bin/verify submissions/ --threads=8 --report=verdicts.txt
+//
+// Each recording is simulated headlessly from its seed and inputs on a worker
+// pool, under the tuning table stored in its header. Every tick's state
+// digest must match the recorded one, and the game must end with the score
+// written into the header. A game whose table was reloaded mid-game is
+// reported as retuned. Mismatches are reported by
+// segment, VERIFY_SEGMENT_TICKS of play, so a reviewer can go straight to that
+// stretch of the game with `desync --dump`. Exit status is 0 when every
+// recording verifies and 2 otherwise.
+
+#define VERIFY_SEGMENT_TICKS 600
+#define VERIFY_MAX_SCREEN_SIZE 8192.0f
+#define VERIFY_KNOWN_ACTIONS (ACTION_THRUST | ACTION_ROTATE_LEFT | ACTION_ROTATE_RIGHT | ACTION_FIRE | ACTION_HYPERSPACE)
+
+typedef enum {
+    VERDICT_VERIFIED,
+    VERDICT_UNREADABLE,
+    VERDICT_MALFORMED,
+    VERDICT_UNFINISHED,
+    VERDICT_DESYNC,
+    VERDICT_SCORE_MISMATCH,
+    VERDICT_RETUNED,
+    VERDICT_COUNT
+} Verdict;
+
+typedef struct {
+    char* path;
+    TuningTable tuning;
+    Verdict verdict;
+    int claimedScore;
+    int score;
+    int ticks;
+    double playTime;
+    double seconds;
+    // First mismatch, for desyncs and malformed ticks
+    uint32_t tick;
+    int segment;
+    unsigned int groups;
+    const char* reason;
+} Verification;
+
+typedef struct {
+    Verification* items;
+    int count;
+    // The recordings of the group being run, which all share one tuning table
+    int* group;
+    int groupCount;
+} VerifyBatch;
+
+static const char* GetVerdictName(Verdict verdict) {
+    static const char* names[VERDICT_COUNT] = {
+        [VERDICT_VERIFIED] = "verified",
+        [VERDICT_UNREADABLE] = "unreadable",
+        [VERDICT_MALFORMED] = "malformed",
+        [VERDICT_UNFINISHED] = "unfinished",
+        [VERDICT_DESYNC] = "desync",
+        [VERDICT_SCORE_MISMATCH] = "score-mismatch",
+        [VERDICT_RETUNED] = "retuned"
+    };
+    return names[verdict];
+}
+
+// Submissions are untrusted: the shape must be one the game can create
+// before any memory is sized from it
+static const char* CheckHeader(const ReplayHeader* header) {
+    if (header->levelSet < 0 || header->levelSet >= LEVEL_SET_COUNT) return "unknown level set";
+    if (header->maxAsteroids < 1 || header->maxAsteroids > MAX_SWARM_ASTEROIDS) return "asteroid capacity out of range";
+    if (!(header->screenWidth >= 1 && header->screenWidth <= VERIFY_MAX_SCREEN_SIZE) ||
+        !(header->screenHeight >= 1 && header->screenHeight <= VERIFY_MAX_SCREEN_SIZE)) {
+        return "screen size out of range";
+    }
+    if (!(header->worldWidth >= header->screenWidth && header->worldWidth <= header->screenWidth * WORLD_SCREENS_WIDE) ||
+        !(header->worldHeight >= header->screenHeight && header->worldHeight <= header->screenHeight * WORLD_SCREENS_HIGH)) {
+        return "world size out of range";
+    }
+    if (CheckTuningTable(&header->tuning)) return "tuning value out of range";
+    return nullptr;
+}
+
+static void Reject(Verification* result, Verdict verdict, uint32_t tick, const char* reason) {
+    result->verdict = verdict;
+    result->tick = tick;
+    result->segment = tick > 0 ? (int)((tick - 1) / VERIFY_SEGMENT_TICKS) : 0;
+    result->reason = reason;
+}
+
+// Replays one recording start to finish, stopping at the first tick that
+// does not match
+static void Simulate(const Replay* replay, Verification* result) {
+    GameState* state = CreateReplayGameState(replay);
+    StateHasher hasher;
+    if (!state || !InitStateHasher(&hasher, replay->header.maxAsteroids)) {
+        DestroyGameState(state);
+        Reject(result, VERDICT_UNREADABLE, 0, "out of memory");
+        return;
+    }
+    
+    for (int i = 0; i < replay->tickCount; i++) {
+        const ReplayTick* tick = &replay->ticks[i];
+        if (replay->header.retunedTick != 0 && tick->tick >= replay->header.retunedTick) {
+            Reject(result, VERDICT_RETUNED, tick->tick, "tuning table reloaded mid-game");
+            break;
+        }
+        if (!(tick->deltaTime >= 0 && tick->deltaTime <= REPLAY_MAX_TICK_TIME) || (tick->actions & ~VERIFY_KNOWN_ACTIONS)) {
+            Reject(result, VERDICT_MALFORMED, tick->tick, "impossible frame time or controls");
+            break;
+        }
+        
+        StepReplay(state, tick);
+        if (i == 0) {
+            ResetStateHasher(&hasher, state);
+        } else {
+            UpdateStateHasher(&hasher, state);
+        }
+        result->playTime += tick->deltaTime;
+        
+        if (state->tick != tick->tick) {
+            Reject(result, VERDICT_MALFORMED, tick->tick, "ticks out of sequence");
+            break;
+        }
+        if (memcmp(&hasher.digest, &tick->digest, sizeof(StateDigest)) != 0) {
+            for (int g = 0; g < STATE_HASH_GROUP_COUNT; g++) {
+                if (hasher.digest.groups[g] != tick->digest.groups[g]) result->groups |= 1u << g;
+            }
+            Reject(result, VERDICT_DESYNC, tick->tick, nullptr);
+            break;
+        }
+    }
+    
+    result->score = state->score;
+    if (result->verdict == VERDICT_VERIFIED) {
+        if (state->state != GAME_STATE_GAME_OVER || result->claimedScore == REPLAY_SCORE_UNFINISHED) {
+            Reject(result, VERDICT_UNFINISHED, state->tick, nullptr);
+        } else if (state->score != result->claimedScore) {
+            Reject(result, VERDICT_SCORE_MISMATCH, state->tick, nullptr);
+        }
+    }
+    
+    FreeStateHasher(&hasher);
+    DestroyGameState(state);
+}
+
+static void VerifyReplayJob(void* context, int index) {
+    VerifyBatch* batch = context;
+    Verification* result = &batch->items[batch->group[index]];
+    double start = GetMonotonicTime();
+    
+    // Workers keep their own effects switch, like their random stream
+    SetEffectsEnabled(false);
+    
+    Replay replay;
+    if (!LoadReplay(result->path, &replay)) {
+        Reject(result, VERDICT_UNREADABLE, 0, "missing, truncated or from another version");
+    } else {
+        const char* problem = CheckHeader(&replay.header);
+        result->claimedScore = replay.header.score;
+        result->ticks = replay.tickCount;
+        if (problem) {
+            Reject(result, VERDICT_MALFORMED, 0, problem);
+        } else if (memcmp(&replay.header.tuning, tuning, sizeof(TuningTable)) != 0) {
+            Reject(result, VERDICT_UNREADABLE, 0, "file changed during verification");
+        } else if (replay.tickCount == 0) {
+            Reject(result, VERDICT_UNFINISHED, 0, nullptr);
+        } else {
+            Simulate(&replay, result);
+        }
+        UnloadReplay(&replay);
+    }
+    
+    result->seconds = GetMonotonicTime() - start;
+}
+
+static bool EndsWith(const char* text, const char* suffix) {
+    size_t length = strlen(text), suffixLength = strlen(suffix);
+    return length >= suffixLength && strcmp(text + length - suffixLength, suffix) == 0;
+}
+
+static int CompareVerifications(const void* a, const void* b) {
+    return strcmp(((const Verification*)a)->path, ((const Verification*)b)->path);
+}
+
+// Every .replay file in the directory, sorted so reports diff cleanly between runs
+static bool ListReplays(const char* directory, VerifyBatch* batch) {
+    DIR* dir = opendir(directory);
+    if (!dir) return false;
+    
+    int capacity = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+        if (!EndsWith(entry->d_name, ".replay")) continue;
+        if (batch->count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            Verification* items = realloc(batch->items, capacity * sizeof(Verification));
+            if (!items) break;
+            batch->items = items;
+        }
+        
+        size_t size = strlen(directory) + strlen(entry->d_name) + 2;
+        char* path = malloc(size);
+        if (!path) break;
+        snprintf(path, size, "%s/%s", directory, entry->d_name);
+        batch->items[batch->count++] = (Verification){
+            .path = path,
+            .tuning = *GetDefaultTuning(),
+            .claimedScore = REPLAY_SCORE_UNFINISHED
+        };
+    }
+    closedir(dir);
+    
+    qsort(batch->items, batch->count, sizeof(Verification), CompareVerifications);
+    return true;
+}
+
+// Headers that cannot be read, or hold an unusable table, keep the default
+// table here; their job rejects them before simulating anything
+static bool ReadTuningTables(VerifyBatch* batch) {
+    for (int i = 0; i < batch->count; i++) {
+        ReplayHeader header;
+        if (LoadReplayHeader(batch->items[i].path, &header) && !CheckTuningTable(&header.tuning)) {
+            batch->items[i].tuning = header.tuning;
+        }
+    }
+    batch->group = malloc((batch->count > 0 ? batch->count : 1) * sizeof(int));
+    return batch->group != nullptr;
+}
+
+// The tuning table is process-wide, so each distinct table gets its own run
+// of the pool, usually just one
+static bool RunTuningGroups(JobPool* pool, VerifyBatch* batch) {
+    bool* done = calloc(batch->count > 0 ? batch->count : 1, sizeof(bool));
+    if (!done) return false;
+    
+    for (int i = 0; i < batch->count; i++) {
+        if (done[i]) continue;
+        const TuningTable* table = &batch->items[i].tuning;
+        
+        batch->groupCount = 0;
+        for (int j = i; j < batch->count; j++) {
+            if (done[j] || memcmp(&batch->items[j].tuning, table, sizeof(TuningTable)) != 0) continue;
+            done[j] = true;
+            batch->group[batch->groupCount++] = j;
+        }
+        
+        SetTuningTable(table);
+        RunJobs(pool, VerifyReplayJob, batch, batch->groupCount);
+    }
+    
+    SetTuningTable(nullptr);
+    free(done);
+    return true;
+}
+
+static void WriteReport(FILE* out, const VerifyBatch* batch, int threads, double seconds) {
+    int counts[VERDICT_COUNT] = { 0 };
+    double playTime = 0, busy = 0;
+    long long ticks = 0;
+    
+    for (int i = 0; i < batch->count; i++) {
+        const Verification* result = &batch->items[i];
+        counts[result->verdict]++;
+        playTime += result->playTime;
+        busy += result->seconds;
+        ticks += result->ticks;
+        
+        fprintf(out, "%-14s %s  claimed %d  replayed %d  %d ticks  %.1f s of play",
+                GetVerdictName(result->verdict), result->path, result->claimedScore, result->score,
+                result->ticks, result->playTime);
+        if (result->verdict == VERDICT_DESYNC || result->verdict == VERDICT_MALFORMED ||
+            result->verdict == VERDICT_RETUNED) {
+            fprintf(out, "  segment %d tick %u", result->segment, result->tick);
+        }
+        for (int g = 0; g < STATE_HASH_GROUP_COUNT; g++) {
+            if (result->groups & (1u << g)) fprintf(out, " %s", GetStateHashGroupName(g));
+        }
+        if (result->reason) fprintf(out, "  (%s)", result->reason);
+        fprintf(out, "\n");
+    }
+    
+    fprintf(out, "\n%d recordings:", batch->count);
+    for (int v = 0; v < VERDICT_COUNT; v++) {
+        if (counts[v]) fprintf(out, " %d %s", counts[v], GetVerdictName(v));
+    }
+    fprintf(out, "\n%.1f s of play, %lld ticks, in %.3f s on %d threads; %.0f s of play per core-second\n",
+            playTime, ticks, seconds, threads, busy > 0 ? playTime / busy : 0.0);
+}
+
+int main(int argc, char** argv) {
+    const char* directory = nullptr;
+    const char* reportPath = nullptr;
+    int threads = GetHardwareThreadCount();
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--threads=", 10) == 0) {
+            threads = atoi(argv[i] + 10);
+        } else if (strncmp(argv[i], "--report=", 9) == 0) {
+            reportPath = argv[i] + 9;
+        } else if (argv[i][0] != '-' && !directory) {
+            directory = argv[i];
+        } else {
+            directory = nullptr;
+            break;
+        }
+    }
+    if (!directory) {
+        fprintf(stderr, "Usage: %s DIRECTORY [--threads=N] [--report=PATH]\n", argv[0]);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    
+    VerifyBatch batch = { 0 };
+    if (!ListReplays(directory, &batch)) {
+        fprintf(stderr, "Failed to read directory: %s\n", directory);
+        return 1;
+    }
+    
+    // The calling thread works too, so the pool holds one fewer
+    JobPool* pool = threads > 1 ? CreateJobPool(threads - 1) : nullptr;
+    double start = GetMonotonicTime();
+    bool grouped = ReadTuningTables(&batch) && RunTuningGroups(pool, &batch);
+    double seconds = GetMonotonicTime() - start;
+    DestroyJobPool(pool);
+    if (!grouped) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    
+    FILE* out = reportPath ? fopen(reportPath, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Failed to write report: %s\n", reportPath);
+        out = stdout;
+    }
+    WriteReport(out, &batch, threads, seconds);
+    if (out != stdout) fclose(out);
+    
+    int result = 0;
+    for (int i = 0; i < batch.count; i++) {
+        if (batch.items[i].verdict != VERDICT_VERIFIED) result = 2;
+        free(batch.items[i].path);
+    }
+    free(batch.items);
+    free(batch.group);
+    return result;
+}